@@ -0,0 +1,114 @@
+// Times loading a generated directory of gear configs: parsed one by one on
+// the calling thread like parseConfigs used to, then through
+// ConfigManifest::Refresh on 1 to 8 worker threads, and a Refresh of the
+// same directory with nothing changed.
+
+#include "configLoader.h"
+#include "gearInfo.h"
+#include "Util/Logger.hpp"
+#include "Util/Timer.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+    void writeConfigs(const fs::path& dir, size_t count) {
+        std::error_code ec;
+        fs::remove_all(dir, ec);
+        fs::create_directories(dir);
+
+        std::mt19937 rng(0xC0FFEE);
+        for (size_t i = 0; i < count; ++i) {
+            const uint8_t topGear = static_cast<uint8_t>(4 + rng() % 7);
+            GearSet ratios;
+            ratios.resize(topGear + 1);
+            ratios[0] = -3.3f;
+            float ratio = 3.0f + static_cast<float>(rng() % 100) / 100.0f;
+            for (uint8_t gear = 1; gear <= topGear; ++gear) {
+                ratios[gear] = ratio;
+                ratio *= 0.75f;
+            }
+            const std::string model = fmt::format("model{:05}", i % 500);
+            const bool plate = i % 3 == 0;
+            GearInfo config(fmt::format("{} preset {}", model, i), model, 0,
+                plate ? fmt::format("{:08}", i) : LoadName::Model, topGear,
+                40.0f + static_cast<float>(rng() % 400) / 10.0f, ratios,
+                plate ? LoadType::Plate : LoadType::Model);
+            GearInfo::SaveConfig(config, (dir / fmt::format("{}_{:05}.xml", model, i)).string());
+        }
+    }
+
+    // What parseConfigs did before the worker pool.
+    size_t loadSerial(const fs::path& dir) {
+        std::vector<GearInfo> configs;
+        for (const auto& entry : fs::directory_iterator(dir)) {
+            if (entry.path().extension() != ".xml")
+                continue;
+            GearInfo info = GearInfo::ParseConfig(entry.path().string());
+            if (!info.ParseError)
+                configs.push_back(info);
+        }
+        return configs.size();
+    }
+
+    size_t loadManifest(ConfigManifest& manifest, const fs::path& dir, unsigned threads) {
+        ConfigManifest::Stats stats;
+        manifest.Refresh(dir.string(), threads, stats);
+        std::vector<GearInfo> configs;
+        manifest.GetConfigs(configs);
+        return configs.size();
+    }
+
+    template <typename F>
+    double timeMs(F fn) {
+        const int64_t start = NowMicros();
+        fn();
+        return static_cast<double>(NowMicros() - start) / 1000.0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    logger.SetFile("CgrConfigLoadBench.log");
+    logger.Clear();
+
+    const size_t count = argc > 1 ? strtoul(argv[1], nullptr, 10) : 10000;
+    const fs::path dir = argc > 2 ? fs::path(argv[2]) : fs::temp_directory_path() / "CgrBench" / "Configs";
+    if (count == 0 || argc > 3) {
+        printf("Usage:\n");
+        printf("    CgrConfigLoadBench [files] [scratch directory]\n");
+        printf("The scratch directory is emptied first.\n");
+        return 1;
+    }
+
+    writeConfigs(dir, count);
+    printf("%zu configs in [%s], %u hardware threads\n",
+        count, dir.string().c_str(), std::thread::hardware_concurrency());
+    printf("%-28s %10s %10s\n", "method", "ms", "configs");
+
+    size_t loaded = 0;
+    double ms = timeMs([&] { loaded = loadSerial(dir); });
+    printf("%-28s %10.2f %10zu\n", "serial", ms, loaded);
+
+    for (unsigned threads : { 1u, 2u, 4u, 8u }) {
+        ConfigManifest manifest;
+        ms = timeMs([&] { loaded = loadManifest(manifest, dir, threads); });
+        printf("%-28s %10.2f %10zu\n", fmt::format("Refresh, {} threads", threads).c_str(), ms, loaded);
+    }
+
+    ConfigManifest manifest;
+    loadManifest(manifest, dir, std::max(1u, std::thread::hardware_concurrency()));
+    ms = timeMs([&] { loaded = loadManifest(manifest, dir, 1); });
+    printf("%-28s %10.2f %10zu\n", "Refresh, unchanged", ms, loaded);
+
+    logger.Close();
+    return loaded == count ? 0 : 1;
+}
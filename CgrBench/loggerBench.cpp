@@ -0,0 +1,158 @@
+// Times logging from 1 to 4 threads: the original Logger, which opened the
+// file and formatted through iostreams for every line, against the queued
+// Logger, with both its printf-style Write and LOG_INFO. For the queued
+// Logger the time is what the callers spend, the writer thread catches up
+// in Flush, which is timed on its own.
+
+#include "Util/Logger.hpp"
+#include "Util/Timer.h"
+
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+    // The original Logger::Write, with the standard clock for GetLocalTime.
+    class LegacyLogger {
+    public:
+        explicit LegacyLogger(std::string file)
+            : mFile(std::move(file)) {}
+
+        void Clear() const {
+            std::lock_guard<std::mutex> lock(mMutex);
+            std::ofstream logFile(mFile, std::ofstream::out | std::ofstream::trunc);
+        }
+
+        void Write(LogLevel level, const std::string& text) const {
+            std::lock_guard<std::mutex> lock(mMutex);
+            std::ofstream logFile(mFile, std::ios_base::out | std::ios_base::app);
+            const auto now = std::chrono::system_clock::now();
+            const time_t seconds = std::chrono::system_clock::to_time_t(now);
+            const tm time = *localtime(&seconds);
+            const auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() % 1000;
+            logFile << "[" <<
+                std::setw(2) << std::setfill('0') << time.tm_hour << ":" <<
+                std::setw(2) << std::setfill('0') << time.tm_min << ":" <<
+                std::setw(2) << std::setfill('0') << time.tm_sec << "." <<
+                std::setw(3) << std::setfill('0') << millis << "] " <<
+                "[" << levelStrings[level] << "] " <<
+                text << "\n";
+        }
+
+        void Write(LogLevel level, const char* fmt, ...) const {
+            const int size = 1024;
+            char buff[size];
+            va_list args;
+            va_start(args, fmt);
+            vsnprintf(buff, size, fmt, args);
+            va_end(args);
+            Write(level, std::string(buff));
+        }
+
+    private:
+        std::string mFile;
+        mutable std::mutex mMutex;
+        const std::vector<std::string> levelStrings{
+            " DEBUG ",
+            " INFO  ",
+            "WARNING",
+            " ERROR ",
+            " FATAL ",
+        };
+    };
+
+    // Lines that made it to the file, without the Logger's own notes.
+    size_t countLines(const fs::path& file) {
+        std::ifstream in(file);
+        std::string line;
+        size_t count = 0;
+        while (std::getline(in, line)) {
+            count += line.find("Managing vehicle") != std::string::npos;
+        }
+        return count;
+    }
+
+    template <typename F>
+    double timeThreadsMs(unsigned threads, size_t lines, F writeLine) {
+        const int64_t start = NowMicros();
+        std::vector<std::thread> workers;
+        for (unsigned thread = 0; thread < threads; ++thread) {
+            workers.emplace_back([&, thread] {
+                for (size_t i = 0; i < lines; ++i)
+                    writeLine(thread, i);
+            });
+        }
+        for (auto& worker : workers)
+            worker.join();
+        return static_cast<double>(NowMicros() - start) / 1000.0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const size_t lines = argc > 1 ? strtoul(argv[1], nullptr, 10) : 20000;
+    const fs::path dir = argc > 2 ? fs::path(argv[2]) : fs::temp_directory_path() / "CgrBench";
+    if (lines == 0 || argc > 3) {
+        printf("Usage:\n");
+        printf("    CgrLoggerBench [lines per thread] [scratch directory]\n");
+        return 1;
+    }
+    fs::create_directories(dir);
+    const fs::path legacyFile = dir / "legacy.log";
+    const fs::path queuedFile = dir / "queued.log";
+
+    printf("%zu lines per thread, %u hardware threads\n", lines, std::thread::hardware_concurrency());
+    printf("%-24s %8s %10s %12s %10s %10s\n", "method", "threads", "ms", "lines/s", "flush ms", "written");
+
+    LegacyLogger legacy(legacyFile.string());
+    logger.SetFile(queuedFile.string());
+
+    bool complete = true;
+    for (unsigned threads : { 1u, 4u }) {
+        const size_t total = lines * threads;
+
+        legacy.Clear();
+        double ms = timeThreadsMs(threads, lines, [&](unsigned thread, size_t i) {
+            legacy.Write(INFO, "Managing vehicle 0x%X (%u) on thread %u", static_cast<unsigned>(i), static_cast<unsigned>(i % 11), thread);
+        });
+        size_t written = countLines(legacyFile);
+        complete &= written == total;
+        printf("%-24s %8u %10.2f %12.0f %10s %10zu\n", "original", threads, ms,
+            static_cast<double>(total) / ms * 1000.0, "-", written);
+
+        for (int method = 0; method < 2; ++method) {
+            logger.Clear();
+            const uint64_t droppedBefore = logger.Dropped();
+            ms = timeThreadsMs(threads, lines, [&](unsigned thread, size_t i) {
+                if (method == 0)
+                    logger.Write(INFO, "Managing vehicle 0x%X (%u) on thread %u", static_cast<unsigned>(i), static_cast<unsigned>(i % 11), thread);
+                else
+                    LOG_INFO("Managing vehicle 0x{:X} ({}) on thread {}", i, i % 11, thread);
+            });
+            const int64_t flushStart = NowMicros();
+            logger.Flush();
+            const double flushMs = static_cast<double>(NowMicros() - flushStart) / 1000.0;
+            written = countLines(queuedFile);
+            const uint64_t dropped = logger.Dropped() - droppedBefore;
+            complete &= written + dropped == total;
+            printf("%-24s %8u %10.2f %12.0f %10.2f %10zu\n", method == 0 ? "queued, Write" : "queued, LOG_INFO",
+                threads, ms, static_cast<double>(total) / ms * 1000.0, flushMs, written);
+            if (dropped != 0)
+                printf("%-24s %8s %10s %12s %10s %10llu\n", "  dropped, queue full", "", "", "", "",
+                    static_cast<unsigned long long>(dropped));
+        }
+    }
+
+    logger.Close();
+    return complete ? 0 : 1;
+}
@@ -0,0 +1,185 @@
+// Times parsing gear configs: the original ParseConfig, which built a
+// pugixml DOM for every file, against the streaming ParseConfig, over the
+// same generated files. Both, and ParseConfig from memory, are checked to
+// read the same values.
+
+#include "gearInfo.h"
+#include "Util/Logger.hpp"
+#include "Util/Timer.h"
+
+#include <fmt/format.h>
+#include <pugixml/pugixml.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+    std::vector<std::string> writeConfigs(const fs::path& dir, size_t count) {
+        std::error_code ec;
+        fs::remove_all(dir, ec);
+        fs::create_directories(dir);
+
+        std::mt19937 rng(0xC0FFEE);
+        std::vector<std::string> files;
+        for (size_t i = 0; i < count; ++i) {
+            const uint8_t topGear = static_cast<uint8_t>(4 + rng() % 7);
+            GearSet ratios;
+            ratios.resize(topGear + 1);
+            ratios[0] = -3.3f;
+            float ratio = 3.0f + static_cast<float>(rng() % 100) / 100.0f;
+            for (uint8_t gear = 1; gear <= topGear; ++gear) {
+                ratios[gear] = ratio;
+                ratio *= 0.75f;
+            }
+            const std::string model = fmt::format("model{:05}", i % 500);
+            const bool plate = i % 3 == 0;
+            GearInfo config(fmt::format("{} preset {}", model, i), model, static_cast<Hash>(rng()),
+                plate ? fmt::format("{:08}", i) : LoadName::Model, topGear,
+                40.0f + static_cast<float>(rng() % 400) / 10.0f, ratios,
+                plate ? LoadType::Plate : LoadType::Model);
+            files.push_back((dir / fmt::format("{}_{:05}.xml", model, i)).string());
+            GearInfo::SaveConfig(config, files.back());
+        }
+        return files;
+    }
+
+    // The original ParseConfig, minus its logging: a DOM per file, a child
+    // lookup per node and a formatted name per gear.
+    GearInfo parseDom(const std::string& file) {
+        pugi::xml_document doc;
+        if (!doc.load_file(file.c_str()))
+            return GearInfo();
+
+        pugi::xml_node vehicleNode = doc.child("Vehicle");
+        pugi::xml_node descriptionNode = vehicleNode.child("Description");
+        pugi::xml_node modelNameNode = vehicleNode.child("ModelName");
+        pugi::xml_node modelHashNode = vehicleNode.child("ModelHash");
+        pugi::xml_node plateTextNode = vehicleNode.child("PlateText");
+        pugi::xml_node topGearNode = vehicleNode.child("TopGear");
+        pugi::xml_node driveMaxVelNode = vehicleNode.child("DriveMaxVel");
+        if (!vehicleNode || !descriptionNode || !modelNameNode || !plateTextNode || !topGearNode || !driveMaxVelNode)
+            return GearInfo();
+
+        int topGearValue = topGearNode.text().as_int();
+        if (topGearValue < 1 || topGearValue >= GearSet::Capacity)
+            return GearInfo();
+
+        uint8_t topGear = static_cast<uint8_t>(topGearValue);
+        GearSet ratios;
+        ratios.resize(topGear + 1);
+        for (uint8_t gear = 0; gear <= topGear; ++gear) {
+            pugi::xml_node gearNode = vehicleNode.child(fmt::format("Gear{}", gear).c_str());
+            if (!gearNode)
+                return GearInfo();
+            ratios[gear] = gearNode.text().as_float();
+        }
+
+        LoadType loadType = LoadType::Plate;
+        if (plateTextNode.text().as_string() == LoadName::None)
+            loadType = LoadType::None;
+        if (plateTextNode.text().as_string() == LoadName::Model)
+            loadType = LoadType::Model;
+
+        return GearInfo(
+            descriptionNode.text().as_string(),
+            modelNameNode.text().as_string(),
+            modelHashNode ? modelHashNode.text().as_uint() : 0,
+            plateTextNode.text().as_string(),
+            topGear,
+            driveMaxVelNode.text().as_float(),
+            ratios,
+            loadType
+        );
+    }
+
+    bool sameConfig(const GearInfo& a, const GearInfo& b) {
+        return a.ParseError == b.ParseError &&
+            a.Description == b.Description &&
+            a.ModelName == b.ModelName &&
+            a.ModelHash == b.ModelHash &&
+            a.LicensePlate == b.LicensePlate &&
+            a.TopGear == b.TopGear &&
+            a.DriveMaxVel == b.DriveMaxVel &&
+            a.LoadType == b.LoadType &&
+            std::equal(a.Ratios.begin(), a.Ratios.end(), b.Ratios.begin(), b.Ratios.end());
+    }
+
+    template <typename F>
+    double medianMs(int runs, F fn) {
+        std::vector<double> times;
+        for (int run = 0; run < runs; ++run) {
+            const int64_t start = NowMicros();
+            fn();
+            times.push_back(static_cast<double>(NowMicros() - start) / 1000.0);
+        }
+        std::sort(times.begin(), times.end());
+        return times[times.size() / 2];
+    }
+}
+
+int main(int argc, char* argv[]) {
+    logger.SetFile("CgrParseBench.log");
+    logger.Clear();
+
+    const size_t count = argc > 1 ? strtoul(argv[1], nullptr, 10) : 2000;
+    const int runs = argc > 2 ? atoi(argv[2]) : 5;
+    const fs::path dir = argc > 3 ? fs::path(argv[3]) : fs::temp_directory_path() / "CgrBench" / "Parse";
+    if (count == 0 || runs <= 0 || argc > 4) {
+        printf("Usage:\n");
+        printf("    CgrParseBench [files] [runs] [scratch directory]\n");
+        printf("The scratch directory is emptied first.\n");
+        return 1;
+    }
+
+    const std::vector<std::string> files = writeConfigs(dir, count);
+    uintmax_t bytes = 0;
+    for (const auto& file : files) {
+        bytes += fs::file_size(file);
+    }
+
+    size_t mismatches = 0;
+    std::vector<char> data;
+    for (const auto& file : files) {
+        const GearInfo config = GearInfo::ParseConfig(file);
+        mismatches += !sameConfig(parseDom(file), config);
+
+        // From memory, like ConfigManifest::Refresh.
+        data.resize(fs::file_size(file) + 1);
+        FILE* f = fopen(file.c_str(), "rb");
+        const size_t size = f ? fread(data.data(), 1, data.size() - 1, f) : 0;
+        if (f)
+            fclose(f);
+        data[size] = '\0';
+        mismatches += !sameConfig(GearInfo::ParseConfig(file, data.data(), size), config);
+    }
+
+    printf("%zu configs, %.1f KiB, median of %d runs\n", count, static_cast<double>(bytes) / 1024.0, runs);
+    printf("%-28s %10s %12s %10s\n", "method", "ms", "files/s", "MiB/s");
+
+    size_t parsed = 0;
+    auto report = [&](const char* method, double ms) {
+        printf("%-28s %10.2f %12.0f %10.2f\n", method, ms,
+            static_cast<double>(count) / ms * 1000.0,
+            static_cast<double>(bytes) / (1024.0 * 1024.0) / ms * 1000.0);
+    };
+
+    report("DOM, original", medianMs(runs, [&] {
+        for (const auto& file : files)
+            parsed += !parseDom(file).ParseError;
+    }));
+    report("ParseConfig, streaming", medianMs(runs, [&] {
+        for (const auto& file : files)
+            parsed += !GearInfo::ParseConfig(file).ParseError;
+    }));
+
+    printf("\n%zu mismatches\n", mismatches);
+    logger.Close();
+    return mismatches == 0 && parsed == count * runs * 2 ? 0 : 1;
+}
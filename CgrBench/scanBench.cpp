@@ -0,0 +1,165 @@
+// Times resolving the script's signatures in a synthetic module image: one
+// scan per pattern, like mem::FindPattern used to do, against a single
+// PatternBatch pass, and that pass split over 1 to 8 threads.
+
+#include "Memory/PatternScanner.hpp"
+#include "Util/Timer.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    // The VehicleExtensions and mem::init signatures, roughly. What matters
+    // here is their length, wildcards and first bytes.
+    const char* signatures[] = {
+        "3A 91 ? ? ? ? 74 ? 84 D2",
+        "48 8B 47 ? F3 44 0F 10 9F ? ? ? ?",
+        "F3 0F 11 B3 ? ? ? ? 44 88 ? ? ? ? ? 48 85 C9",
+        "74 26 0F 57 C9",
+        "48 8D 8F ? ? ? ? 4C 8B C3 F3 0F 11 7C 24",
+        "F3 0F 10 8F ? ? ? ? F3 0F 5E F0 41 0F 2F CA",
+        "76 03 0F 28 F0 F3 44 0F 10 93",
+        "F3 0F 10 9F ? ? ? ? 0F 2F DF 73 0A",
+        "3C 03 0F 85 ? ? ? ? 48 8B 41 20 48 8B 88",
+        "FD 02 DB 08 98 ? ? ? ? 48 8B 5C 24 30",
+        "44 0F B7 91 ? ? ? ? 0F B7 81 ? ? ? ? 41 B9 01 00 00 00 44 03 15",
+        "74 0A F3 0F 11 B3 ? ? ? ? EB 25",
+        "0F 29 7C 24 30 0F 85 ? ? ? ? F3 0F 10 B9",
+        "F3 0F 11 9B ? ? ? ? 0F 84 B1 00 00 00",
+        "F3 0F 10 8F ? ? ? ? F3 0F 59 05",
+        "8B 83 ? ? ? ? 83 E8 ? 83 F8 02",
+        "3B B7 ? ? ? ? 7D 0D",
+        "48 85 C0 74 3C 8B 80 ? ? ? ? C1 E8 0F",
+        "0F BA AB ? ? ? ? 09 0F 2F B3 ? ? ? ? 48 8B 83",
+        "75 11 48 8B 01 8B 88",
+        "75 24 F3 0F 10 81 ? ? ? F3 0F 5C C1",
+        "45 0F 57 ? F3 0F 11 83 ? ? ? F3 0F 5C",
+        "0F 2F 81 ? ? ? 00 0F 97 C0 EB ? D1 ?",
+        "89 8B ? ? 00 00 E8 ? ? ? ? 0F 57 ?",
+        "88 8B ? ? 00 00 41 0F B6 47 51 66 89 83 ? ? 00 00",
+        "83 F9 FF 74 31 4C 8B 0D ? ? ? ? 44 8B C1 49 8B 41 08",
+        "0F B7 05 ? ? ? ? 45 33 C9 4C 8B DA 66 85 C0 0F 84 ? ? ? ? 44 0F B7 C0",
+        "EB 09 41 3B 0A 74 54",
+    };
+
+    // Code-like bytes: mostly common opcode and operand bytes, so anchors
+    // have plenty of false candidates, like in the game's .text.
+    std::vector<uint8_t> makeImage(size_t size, std::mt19937& rng) {
+        const uint8_t common[] = { 0x00, 0x48, 0x8B, 0x0F, 0xF3, 0x89, 0xE8, 0x83, 0x74, 0x75, 0xC0, 0xCC, 0x44, 0x10 };
+        std::vector<uint8_t> image(size);
+        for (auto& byte : image) {
+            const uint32_t r = rng();
+            byte = (r & 3) != 0 ? common[(r >> 8) % sizeof(common)] : static_cast<uint8_t>(r >> 16);
+        }
+        return image;
+    }
+
+    void plant(std::vector<uint8_t>& image, const mem::Pattern& pattern, size_t offset) {
+        for (size_t i = 0; i < pattern.Size(); ++i) {
+            if (pattern.Mask[i])
+                image[offset + i] = pattern.Bytes[i];
+        }
+    }
+
+    // The original mem::FindPattern loop.
+    uintptr_t legacyFind(const mem::Pattern& pattern, const uint8_t* start, size_t size) {
+        size_t pos = 0;
+        const size_t searchLen = pattern.Size() - 1;
+        for (const uint8_t* address = start; address < start + size; ++address) {
+            if (*address == pattern.Bytes[pos] || pattern.Mask[pos] == 0x00) {
+                if (pos == searchLen)
+                    return reinterpret_cast<uintptr_t>(address) - searchLen;
+                ++pos;
+            }
+            else {
+                pos = 0;
+            }
+        }
+        return 0;
+    }
+
+    template <typename F>
+    double medianMs(int runs, F fn) {
+        std::vector<double> times;
+        for (int run = 0; run < runs; ++run) {
+            const int64_t start = NowMicros();
+            fn();
+            times.push_back(static_cast<double>(NowMicros() - start) / 1000.0);
+        }
+        std::sort(times.begin(), times.end());
+        return times[times.size() / 2];
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const size_t mib = argc > 1 ? strtoul(argv[1], nullptr, 10) : 64;
+    const int runs = argc > 2 ? atoi(argv[2]) : 5;
+    if (mib == 0 || runs <= 0) {
+        printf("Usage:\n");
+        printf("    CgrScanBench [image MiB] [runs]\n");
+        return 1;
+    }
+
+    std::mt19937 rng(0xC0FFEE);
+    std::vector<mem::Pattern> patterns;
+    for (const char* signature : signatures) {
+        patterns.emplace_back(signature);
+    }
+
+    // Every signature once, anywhere in the image.
+    std::vector<uint8_t> image = makeImage(mib * 1024 * 1024, rng);
+    for (const auto& pattern : patterns) {
+        plant(image, pattern, rng() % (image.size() - pattern.Size()));
+    }
+
+    printf("%zu signatures, %zu MiB image, median of %d runs\n", patterns.size(), mib, runs);
+    printf("%-28s %10s\n", "method", "ms");
+
+    uintptr_t sink = 0;
+    const double legacyMs = medianMs(runs, [&] {
+        for (const auto& pattern : patterns)
+            sink += legacyFind(pattern, image.data(), image.size());
+    });
+    printf("%-28s %10.2f\n", "per pattern, byte loop", legacyMs);
+
+    const double findMs = medianMs(runs, [&] {
+        for (const auto& pattern : patterns)
+            sink += mem::Find(pattern, image.data(), image.size());
+    });
+    printf("%-28s %10.2f\n", "per pattern, mem::Find", findMs);
+
+    mem::PatternBatch batch;
+    for (const auto& pattern : patterns) {
+        batch.Add(pattern);
+    }
+    const double batchMs = medianMs(runs, [&] {
+        batch.Scan(image.data(), image.size(), 1);
+    });
+    printf("%-28s %10.2f\n", "PatternBatch, single pass", batchMs);
+
+    // Same pass, chunked over threads like ScanModule does. A single thread
+    // stops once everything's found, chunks each scan to their end.
+    printf("\n%u hardware threads\n", std::thread::hardware_concurrency());
+    printf("%-28s %10s %10s\n", "threads", "ms", "speedup");
+    double oneThreadMs = 0.0;
+    for (unsigned threads : { 1u, 2u, 4u, 8u }) {
+        const double threadsMs = medianMs(runs, [&] {
+            batch.Scan(image.data(), image.size(), threads);
+        });
+        if (threads == 1)
+            oneThreadMs = threadsMs;
+        printf("%-28u %10.2f %9.2fx\n", threads, threadsMs, oneThreadMs / threadsMs);
+    }
+
+    size_t resolved = 0;
+    for (size_t id = 0; id < batch.Count(); ++id) {
+        resolved += batch.Get(id) != 0;
+    }
+    printf("\n%zu of %zu resolved (checksum %zx)\n", resolved, batch.Count(), static_cast<size_t>(sink & 0xFFFF));
+    return resolved == batch.Count() ? 0 : 1;
+}
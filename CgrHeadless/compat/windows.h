@@ -0,0 +1,18 @@
+#pragma once
+// Stand-in for the few Windows types the ScriptHookV SDK headers and the
+// portable sources use, so they compile outside Windows. Sizes match Win64.
+
+#include <cstdint>
+
+typedef uint32_t DWORD;
+typedef uint16_t WORD;
+typedef uint8_t BYTE;
+typedef int BOOL;
+typedef unsigned int UINT;
+typedef uint64_t UINT64;
+typedef UINT64* PUINT64;
+typedef void* HMODULE;
+
+#define MAXDWORD 0xffffffff
+
+#define __declspec(x)
@@ -0,0 +1,281 @@
+// Runs the gearbox logic against a simulated world, without the game: the
+// offset scan, config loading, and a tick loop of player, NPC, CVT, restore
+// and reapply work over N vehicles in plain memory. Prints where the time
+// went, and checks every vehicle ends up with the gears it should have.
+
+#include "nativeStandin.h"
+#include "simWorld.h"
+
+#include "configIndex.h"
+#include "configLoader.h"
+#include "gearInfo.h"
+#include "gearManager.h"
+#include "Memory/VehicleExtensions.hpp"
+#include "Memory/Versions.h"
+#include "Util/Logger.hpp"
+#include "Util/Profiler.h"
+#include "Util/Strings.h"
+#include "Util/Timer.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr int tickMs = 16;
+    constexpr size_t moduleSize = 32 * 1024 * 1024;
+    // Models without a config, out of every 4.
+    constexpr size_t modelCount = 96;
+    constexpr size_t plateConfigs = 64;
+    constexpr uint32_t plateCount = 2000;
+
+    enum Stage : size_t {
+        StageWorld,
+        StagePlayer,
+        StageNPC,
+        StageCVT,
+        StageRestore,
+        StageReapply,
+    };
+
+    void printUsage() {
+        printf("Usage:\n");
+        printf("    CgrHeadless [vehicles] [ticks] [config directory]\n");
+        printf("Without a config directory, presets for the simulated models are generated.\n");
+    }
+
+    std::string modelName(size_t model) {
+        return fmt::format("simcar{:03}", model);
+    }
+
+    std::string plateText(uint32_t plate) {
+        return fmt::format("{:08}", plate);
+    }
+
+    const SimWorld::Stock stockGears = {
+        6, 50.0f, GearSet(std::array<float, 7>{ -3.5f, 3.5f, 2.1f, 1.4f, 1.0f, 0.8f, 0.65f }.data(), 7),
+    };
+
+    GearInfo makeConfig(SimWorld& world, size_t model, const std::string& plate, LoadType loadType) {
+        // Some single-gear ones, for the CVT.
+        const uint8_t topGear = world.Random() % 16 == 0 ? 1 : static_cast<uint8_t>(4 + world.Random() % 7);
+        GearSet ratios;
+        ratios.resize(topGear + 1);
+        ratios[0] = -3.3f;
+        float ratio = 3.0f + static_cast<float>(world.Random() % 100) / 100.0f;
+        for (uint8_t gear = 1; gear <= topGear; ++gear) {
+            ratios[gear] = ratio;
+            ratio *= 0.75f;
+        }
+        const float driveMaxVel = 40.0f + static_cast<float>(world.Random() % 400) / 10.0f;
+        return GearInfo(fmt::format("{} {}-speed", modelName(model), topGear), modelName(model), 0,
+            plate, topGear, driveMaxVel, ratios, loadType);
+    }
+
+    // A generic config for three out of four models, and some plate-specific ones.
+    void writeConfigs(SimWorld& world, const fs::path& dir) {
+        std::error_code ec;
+        fs::remove_all(dir, ec);
+        fs::create_directories(dir);
+        for (size_t model = 0; model < modelCount; ++model) {
+            if (model % 4 == 3)
+                continue;
+            GearInfo config = makeConfig(world, model, LoadName::Model, LoadType::Model);
+            GearInfo::SaveConfig(config, (dir / fmt::format("{}.xml", modelName(model))).string());
+        }
+        for (size_t i = 0; i < plateConfigs; ++i) {
+            const size_t model = world.Random() % modelCount;
+            const std::string plate = plateText(world.Random() % plateCount);
+            GearInfo config = makeConfig(world, model, plate, LoadType::Plate);
+            GearInfo::SaveConfig(config, (dir / fmt::format("{}_{}.xml", modelName(model), plate)).string());
+        }
+    }
+
+    Vehicle spawn(SimWorld& world, const std::vector<Hash>& models) {
+        const Hash model = models[world.Random() % models.size()];
+        return world.Spawn(model, plateText(world.Random() % plateCount), stockGears);
+    }
+
+    // Gear 1 of single-gear vehicles is the CVT's.
+    bool gearsEqual(BYTE* address, uint8_t topGear, float driveMaxVel, const GearSet& ratios) {
+        const uint8_t count = topGear == 1 ? 1 : static_cast<uint8_t>(ratios.size());
+        return VehicleView(address).GearsEqual(topGear, driveMaxVel, ratios.data(), count);
+    }
+
+    // Vehicles that don't have the gears they should, after everything settled:
+    // their config if there is one, stock otherwise. Nothing here edits gears
+    // by hand, so managed vehicles are held at the same.
+    size_t countMismatches(SimWorld& world, GearManager& manager, const std::vector<GearInfo>& configs) {
+        size_t mismatches = 0;
+        for (size_t i = 0; i < world.Count(); ++i) {
+            const Vehicle vehicle = world.At(i);
+            BYTE* address = world.Address(vehicle);
+            const size_t configIndex = manager.FindConfig(vehicle);
+            bool ok;
+            if (configIndex == ConfigIndex::npos) {
+                ok = gearsEqual(address, stockGears.TopGear, stockGears.DriveMaxVel, stockGears.Ratios);
+            }
+            else {
+                const GearInfo& config = configs[configIndex];
+                ok = gearsEqual(address, config.TopGear, config.DriveMaxVel, config.Ratios);
+            }
+            if (!ok) {
+                logger.Write(ERROR, "[Headless] 0x%X doesn't have the expected gears", vehicle);
+                ++mismatches;
+            }
+        }
+        return mismatches;
+    }
+
+    void printSummary(const TickProfiler& profiler) {
+        printf("%-16s %10s %10s %10s %8s\n", "stage", "p50 us", "p99 us", "max us", "ticks");
+        for (size_t stage = 0; stage <= profiler.Stages(); ++stage) {
+            const auto summary = profiler.Summarize(stage);
+            const std::string name = stage == profiler.Stages() ? "total" : profiler.StageName(stage);
+            printf("%-16s %10.2f %10.2f %10.2f %8zu\n",
+                name.c_str(), summary.P50, summary.P99, summary.Max, summary.Samples);
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    logger.SetFile("CgrHeadless.log");
+    logger.Clear();
+
+    if (argc > 4) {
+        printUsage();
+        return 1;
+    }
+    const int vehicleCount = argc > 1 ? atoi(argv[1]) : 300;
+    const int ticks = argc > 2 ? atoi(argv[2]) : 3600;
+    if (vehicleCount <= 0 || ticks <= 0) {
+        printUsage();
+        return 1;
+    }
+
+    SimWorld world(static_cast<size_t>(vehicleCount), 0xC0FFEE);
+
+    // Offsets, from the stand-in module.
+    const std::vector<uint8_t> module = world.ModuleImage(moduleSize);
+    Standin::SetModule(module.data(), module.size());
+    Standin::SetWorld(&world);
+    VehicleExtensions::SetVersion(G_VER_1_0_1604_0_STEAM);
+    int64_t start = NowMicros();
+    VehicleExtensions::Init();
+    printf("Offsets resolved from %zu MiB in %.3f ms\n",
+        module.size() / (1024 * 1024), static_cast<double>(NowMicros() - start) / 1000.0);
+
+    // Configs
+    const fs::path configDir = argc > 3 ? fs::path(argv[3]) : fs::temp_directory_path() / "CgrHeadless" / "Configs";
+    if (argc <= 3) {
+        writeConfigs(world, configDir);
+    }
+    else if (!fs::is_directory(configDir)) {
+        printf("[%s] is not a directory\n", configDir.string().c_str());
+        return 1;
+    }
+
+    ConfigManifest manifest;
+    ConfigManifest::Stats stats;
+    start = NowMicros();
+    manifest.Refresh(configDir.string(), std::max(1u, std::thread::hardware_concurrency()), stats);
+    std::vector<GearInfo> configs;
+    manifest.GetConfigs(configs);
+    ConfigIndex index;
+    index.Build(configs);
+    printf("Loaded %zu configs (%zu with errors) in %.3f ms\n",
+        configs.size(), stats.Total - configs.size(), static_cast<double>(NowMicros() - start) / 1000.0);
+
+    // Vehicles get the simulated models, and the ones the configs are for.
+    std::vector<Hash> models;
+    for (size_t model = 0; model < modelCount; ++model) {
+        models.push_back(StrUtil::joaat(modelName(model).c_str()));
+    }
+    for (const auto& config : configs) {
+        models.push_back(StrUtil::joaat(config.ModelName.c_str()));
+    }
+    while (world.Count() < world.Capacity()) {
+        spawn(world, models);
+    }
+
+    GearManager manager(world, configs, index);
+    size_t restored = 0;
+    manager.SetRestoreCallback([&](Vehicle, const ManagedGears&) { ++restored; });
+
+    TickProfiler profiler({ "world", "player", "npc", "cvt", "restore", "reapply" });
+    Vehicle player = 0;
+    for (int tick = 0; tick < ticks; ++tick) {
+        profiler.BeginTick();
+        {
+            TickProfiler::Scope scope(profiler, StageWorld);
+            world.Advance(tickMs);
+            // Traffic comes and goes, the player's vehicle stays.
+            if (world.Random() % 4 == 0) {
+                const Vehicle vehicle = world.At(world.Random() % world.Count());
+                if (vehicle != player) {
+                    world.Despawn(vehicle);
+                    spawn(world, models);
+                }
+            }
+            // The game changes managed vehicles' gears, like LSC upgrades.
+            if (tick % 30 == 0 && !manager.Managed().Empty()) {
+                world.Tune(manager.Managed().HandleAt(world.Random() % manager.Managed().Size()));
+            }
+        }
+        {
+            TickProfiler::Scope scope(profiler, StagePlayer);
+            // Get in another vehicle every second.
+            if (tick % 60 == 0) {
+                player = world.At(world.Random() % world.Count());
+                manager.Manage(player);
+                const size_t configIndex = manager.FindConfig(player);
+                if (configIndex != ConfigIndex::npos)
+                    manager.Apply(player, configs[configIndex], true);
+            }
+        }
+        {
+            TickProfiler::Scope scope(profiler, StageNPC);
+            manager.UpdateNPC(8, 500);
+        }
+        {
+            TickProfiler::Scope scope(profiler, StageCVT);
+            BYTE* address = world.Address(player);
+            if (address) {
+                VehicleView view(address);
+                if (view.GetTopGear() == 1) {
+                    const float maxVel = view.GetDriveMaxFlatVel();
+                    const float speed = maxVel * static_cast<float>(tick % 600) / 600.0f;
+                    *view.GetGearRatioPtr(1) = CvtRatio(speed, maxVel, 0.8f, 3.3f, 0.9f, 0.75f);
+                }
+            }
+        }
+        {
+            TickProfiler::Scope scope(profiler, StageRestore);
+            manager.Restore(player);
+        }
+        if (tick % 60 == 59) {
+            TickProfiler::Scope scope(profiler, StageReapply);
+            manager.Reapply(true);
+        }
+    }
+
+    printSummary(profiler);
+
+    // Let everything settle: all NPC vehicles looked at, all changes restored.
+    world.Advance(60000);
+    manager.UpdateNPC(INT_MAX, INT_MAX);
+    manager.Reapply(true);
+    const size_t mismatches = countMismatches(world, manager, configs);
+    printf("%zu vehicles, %zu managed, %zu restores, %zu mismatches\n",
+        world.Count(), manager.Managed().Size(), restored, mismatches);
+
+    logger.Close();
+    return mismatches == 0 ? 0 : 1;
+}
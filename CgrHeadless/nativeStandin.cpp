@@ -0,0 +1,77 @@
+#include "nativeStandin.h"
+
+#include "Memory/NativeMemory.hpp"
+#include "Memory/PatternScanner.hpp"
+#include "Util/Logger.hpp"
+#include "Util/Timer.h"
+
+#include <inc/main.h>
+
+#include <algorithm>
+#include <thread>
+
+namespace {
+    const uint8_t* moduleStart = nullptr;
+    size_t moduleSize = 0;
+    GearWorld* world = nullptr;
+
+    uintptr_t getAddressOfEntity(int entity) {
+        return world ? reinterpret_cast<uintptr_t>(world->Address(entity)) : 0;
+    }
+}
+
+namespace Standin {
+    void SetModule(const uint8_t* start, size_t size) {
+        moduleStart = start;
+        moduleSize = size;
+    }
+
+    void SetWorld(GearWorld* newWorld) {
+        world = newWorld;
+    }
+}
+
+// The game version comes from VehicleExtensions::SetVersion.
+eGameVersion getGameVersion() {
+    return VER_UNK;
+}
+
+namespace mem {
+    uintptr_t(*GetAddressOfEntity)(int entity) = getAddressOfEntity;
+    uintptr_t(*GetModelInfo)(unsigned int modelHash, int* index) = nullptr;
+
+    // Entity lookups are the world's, there's nothing to find for them.
+    void init() {}
+    void initPatterns(PatternBatch&) {}
+    void initResolve(const PatternBatch&) {}
+    void SetExeVersion(SVersion) {}
+
+    // No offset cache, the module is rebuilt every run.
+    void ScanModule(PatternBatch& batch, const std::string&) {
+        const int64_t start = NowMicros();
+        const unsigned threads = std::max(1u, std::min(std::thread::hardware_concurrency(), 4u));
+        batch.Scan(moduleStart, moduleSize, threads);
+        logger.Write(INFO, "Scanned for %u patterns in %.3f ms (%u threads)",
+            static_cast<unsigned>(batch.Count()), static_cast<double>(NowMicros() - start) / 1000.0, threads);
+    }
+
+    uintptr_t FindPattern(const char* pattern, const char* mask) {
+        return FindPattern(Pattern(pattern, mask));
+    }
+
+    uintptr_t FindPattern(const char* pattStr) {
+        return FindPattern(Pattern(pattStr));
+    }
+
+    uintptr_t FindPattern(PatternView pattern) {
+        return Find(pattern, moduleStart, moduleSize);
+    }
+
+    std::vector<uintptr_t> FindPatterns(const char* pattern, const char* mask) {
+        return FindPatterns(Pattern(pattern, mask));
+    }
+
+    std::vector<uintptr_t> FindPatterns(PatternView pattern) {
+        return FindAll(pattern, moduleStart, moduleSize);
+    }
+}
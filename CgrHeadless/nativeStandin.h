@@ -0,0 +1,15 @@
+#pragma once
+#include "gearWorld.h"
+
+#include <cstddef>
+#include <cstdint>
+
+// Stands in for the game-side natives the portable sources link against:
+// the mem:: module scan and entity lookups, and ScriptHookV's getGameVersion.
+// Everything resolves against what's set here instead of the game process.
+namespace Standin {
+    // What mem::ScanModule and mem::FindPattern scan instead of the game module.
+    void SetModule(const uint8_t* start, size_t size);
+    // What mem::GetAddressOfEntity resolves handles with.
+    void SetWorld(GearWorld* world);
+}
@@ -0,0 +1,151 @@
+#include "simWorld.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    // The instructions VehicleExtensions resolves the gear offsets from, the
+    // offset goes in at the given position.
+    struct Instruction {
+        std::vector<uint8_t> Bytes;
+        size_t OffsetAt;
+    };
+
+    const Instruction nextGearInstruction = {
+        { 0x48, 0x8D, 0x8F, 0x00, 0x00, 0x00, 0x00, 0x4C, 0x8B, 0xC3, 0xF3, 0x0F, 0x11, 0x7C, 0x24 }, 3 };
+    const Instruction driveForceInstruction = {
+        { 0xF3, 0x0F, 0x10, 0x8F, 0x00, 0x00, 0x00, 0x00, 0xF3, 0x0F, 0x5E, 0xF0, 0x41, 0x0F, 0x2F, 0xCA }, 4 };
+
+    void plant(std::vector<uint8_t>& image, size_t at, const Instruction& instruction, int offset) {
+        std::copy(instruction.Bytes.begin(), instruction.Bytes.end(), image.begin() + at);
+        memcpy(image.data() + at + instruction.OffsetAt, &offset, sizeof(offset));
+    }
+
+    template <typename T>
+    T& field(BYTE* vehicle, int offset) {
+        return *reinterpret_cast<T*>(vehicle + offset);
+    }
+}
+
+SimWorld::SimWorld(size_t capacity, uint32_t seed)
+    : mMemory(capacity * VehicleSize)
+    , mSlots(capacity)
+    , mRandom(seed == 0 ? 1 : seed) {
+    mFree.reserve(mSlots.size());
+    for (size_t i = mSlots.size(); i > 0; --i) {
+        mFree.push_back(i - 1);
+    }
+    mLive.reserve(mSlots.size());
+}
+
+std::vector<uint8_t> SimWorld::ModuleImage(size_t moduleSize) {
+    const size_t minSize = nextGearInstruction.Bytes.size() + driveForceInstruction.Bytes.size();
+    std::vector<uint8_t> image(std::max(moduleSize, minSize));
+    for (auto& byte : image) {
+        byte = static_cast<uint8_t>(Random());
+    }
+
+    // Apart, so a chunked scan has to get them from different chunks.
+    const size_t half = image.size() / 2;
+    plant(image, Random() % (half - nextGearInstruction.Bytes.size() + 1),
+        nextGearInstruction, NextGearOffset);
+    plant(image, half + Random() % (image.size() - half - driveForceInstruction.Bytes.size() + 1),
+        driveForceInstruction, DriveForceOffset);
+    return image;
+}
+
+Vehicle SimWorld::Spawn(Hash model, const std::string& plate, const Stock& stock) {
+    if (mFree.empty())
+        return 0;
+    const size_t index = mFree.back();
+    mFree.pop_back();
+
+    Slot& slot = mSlots[index];
+    ++slot.Generation;
+    slot.Handle = static_cast<Vehicle>(((index + 1) << 8) | slot.Generation);
+    slot.Live = mLive.size();
+    slot.Model = model;
+    strncpy(slot.Plate, plate.c_str(), sizeof(slot.Plate) - 1);
+    slot.Plate[sizeof(slot.Plate) - 1] = '\0';
+    mLive.push_back(slot.Handle);
+
+    BYTE* vehicle = &mMemory[index * VehicleSize];
+    memset(vehicle, 0, VehicleSize);
+    field<uint16_t>(vehicle, NextGearOffset) = 1;
+    field<uint16_t>(vehicle, NextGearOffset + 2) = 1;
+    field<uint8_t>(vehicle, NextGearOffset + 6) = stock.TopGear;
+    memcpy(vehicle + NextGearOffset + 8, stock.Ratios.data(), stock.Ratios.size() * sizeof(float));
+    field<float>(vehicle, DriveForceOffset) = 0.3f;
+    field<float>(vehicle, DriveForceOffset + 4) = stock.DriveMaxVel / 1.2f;
+    field<float>(vehicle, DriveForceOffset + 8) = stock.DriveMaxVel;
+    return slot.Handle;
+}
+
+void SimWorld::Despawn(Vehicle vehicle) {
+    Slot* slot = find(vehicle);
+    if (!slot)
+        return;
+
+    // Swap with the last live vehicle, order doesn't matter to the game either.
+    const Vehicle last = mLive.back();
+    mLive[slot->Live] = last;
+    find(last)->Live = slot->Live;
+    mLive.pop_back();
+
+    slot->Handle = 0;
+    mFree.push_back(static_cast<size_t>(slot - mSlots.data()));
+}
+
+void SimWorld::Tune(Vehicle vehicle) {
+    BYTE* address = Address(vehicle);
+    if (!address)
+        return;
+
+    // Like a gearbox upgrade: shorter gears, more top speed.
+    const uint8_t topGear = field<uint8_t>(address, NextGearOffset + 6);
+    for (uint8_t gear = 1; gear <= topGear && gear < GearSet::Capacity; ++gear) {
+        field<float>(address, NextGearOffset + 8 + gear * 4) *= 1.1f;
+    }
+    field<float>(address, DriveForceOffset + 4) *= 1.05f;
+    field<float>(address, DriveForceOffset + 8) *= 1.05f;
+}
+
+uint32_t SimWorld::Random() {
+    // xorshift32
+    mRandom ^= mRandom << 13;
+    mRandom ^= mRandom >> 17;
+    mRandom ^= mRandom << 5;
+    return mRandom;
+}
+
+bool SimWorld::Exists(Vehicle vehicle) {
+    return find(vehicle) != nullptr;
+}
+
+Hash SimWorld::Model(Vehicle vehicle) {
+    Slot* slot = find(vehicle);
+    return slot ? slot->Model : 0;
+}
+
+const char* SimWorld::Plate(Vehicle vehicle) {
+    Slot* slot = find(vehicle);
+    return slot ? slot->Plate : nullptr;
+}
+
+int SimWorld::AllVehicles(Vehicle* vehicles, int capacity) {
+    const int count = std::min(capacity, static_cast<int>(mLive.size()));
+    std::copy(mLive.begin(), mLive.begin() + count, vehicles);
+    return count;
+}
+
+BYTE* SimWorld::Address(Vehicle vehicle) {
+    Slot* slot = find(vehicle);
+    return slot ? &mMemory[static_cast<size_t>(slot - mSlots.data()) * VehicleSize] : nullptr;
+}
+
+SimWorld::Slot* SimWorld::find(Vehicle vehicle) {
+    const size_t index = (static_cast<uint32_t>(vehicle) >> 8) - 1;
+    if (vehicle <= 0 || index >= mSlots.size() || mSlots[index].Handle != vehicle)
+        return nullptr;
+    return &mSlots[index];
+}
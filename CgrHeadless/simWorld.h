@@ -0,0 +1,76 @@
+#pragma once
+#include "gearInfo.h"
+#include "gearWorld.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// A world of vehicles in plain memory, to run the gearbox logic without the
+// game. Each vehicle is a zeroed block with its gears at fixed offsets.
+// ModuleImage() is a stand-in game module that has the instructions the
+// gear offsets are resolved from, so VehicleExtensions::Init finds this
+// layout by scanning it.
+class SimWorld : public GearWorld {
+public:
+    static constexpr size_t VehicleSize = 0x1000;
+    // b1604+ layout.
+    static constexpr int NextGearOffset = 0x8C0;
+    static constexpr int DriveForceOffset = 0x8A4;
+
+    // Gears a vehicle spawns with.
+    struct Stock {
+        uint8_t TopGear;
+        float DriveMaxVel;
+        GearSet Ratios;
+    };
+
+    // Up to capacity vehicles at once.
+    SimWorld(size_t capacity, uint32_t seed);
+
+    // moduleSize bytes of filler, with the gear instructions somewhere in it.
+    std::vector<uint8_t> ModuleImage(size_t moduleSize);
+
+    // Returns the new handle, or 0 if the world is full. Slots are reused
+    // with new handles, like game handles.
+    Vehicle Spawn(Hash model, const std::string& plate, const Stock& stock);
+    void Despawn(Vehicle vehicle);
+    size_t Count() const { return mLive.size(); }
+    size_t Capacity() const { return mSlots.size(); }
+    // Live vehicle i, for 0 <= i < Count(). Despawning reorders them.
+    Vehicle At(size_t i) const { return mLive[i]; }
+
+    void Advance(int milliseconds) { mGameTime += milliseconds; }
+    // Changes a vehicle's gears like a tuning upgrade would.
+    void Tune(Vehicle vehicle);
+    uint32_t Random();
+
+    bool Exists(Vehicle vehicle) override;
+    Hash Model(Vehicle vehicle) override;
+    const char* Plate(Vehicle vehicle) override;
+    int AllVehicles(Vehicle* vehicles, int capacity) override;
+    BYTE* Address(Vehicle vehicle) override;
+    int GameTimer() override { return mGameTime; }
+
+private:
+    struct Slot {
+        Vehicle Handle = 0;
+        // Bumped on every spawn, so handles aren't reused right away.
+        uint8_t Generation = 0;
+        // Position in mLive.
+        size_t Live = 0;
+        Hash Model = 0;
+        char Plate[9] = {};
+    };
+
+    // Slot of a live vehicle, or nullptr.
+    Slot* find(Vehicle vehicle);
+
+    std::vector<BYTE> mMemory;
+    std::vector<Slot> mSlots;
+    std::vector<size_t> mFree;
+    std::vector<Vehicle> mLive;
+    uint32_t mRandom;
+    int mGameTime = 0;
+};
@@ -0,0 +1,93 @@
+// Packs a Configs directory into a configs.cgrpack, or unpacks one back into
+// XML files. The mod keeps its pack up to date by itself, this is for
+// shipping a pre-built pack with a preset collection, or inspecting one.
+
+#include "configLoader.h"
+#include "configPack.h"
+#include "gearInfo.h"
+#include "Util/Logger.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace {
+    void printUsage() {
+        printf("Usage:\n");
+        printf("    CgrPack pack <config directory> <output .cgrpack>\n");
+        printf("    CgrPack unpack <input .cgrpack> <output directory>\n");
+    }
+
+    int pack(const std::string& configDir, const std::string& packFile) {
+        if (!fs::is_directory(configDir)) {
+            printf("[%s] is not a directory\n", configDir.c_str());
+            return 1;
+        }
+
+        ConfigManifest manifest;
+        ConfigManifest::Stats stats;
+        manifest.Refresh(configDir, std::max(1u, std::thread::hardware_concurrency()), stats);
+
+        std::vector<GearInfo> configs;
+        manifest.GetConfigs(configs);
+        if (!manifest.SavePack(packFile)) {
+            printf("Failed to write [%s]\n", packFile.c_str());
+            return 1;
+        }
+
+        printf("Packed %zu configs (%zu with errors) into [%s]\n",
+            configs.size(), stats.Total - configs.size(), packFile.c_str());
+        return 0;
+    }
+
+    int unpack(const std::string& packFile, const std::string& outDir) {
+        std::vector<ConfigPack::Item> items;
+        if (!ConfigPack::Load(packFile, items)) {
+            printf("Failed to read [%s], see CgrPack.log\n", packFile.c_str());
+            return 1;
+        }
+
+        std::error_code ec;
+        fs::create_directories(outDir, ec);
+        if (ec) {
+            printf("Failed to create [%s]: %s\n", outDir.c_str(), ec.message().c_str());
+            return 1;
+        }
+
+        size_t written = 0;
+        for (const auto& item : items) {
+            // Configs that failed to parse have nothing to write back.
+            if (item.Info.ParseError)
+                continue;
+            fs::path file = fs::path(outDir) / fs::path(item.Info.Path).filename();
+            GearInfo::SaveConfig(item.Info, file.string());
+            ++written;
+        }
+
+        printf("Unpacked %zu of %zu configs into [%s]\n", written, items.size(), outDir.c_str());
+        return 0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    logger.SetFile("CgrPack.log");
+    logger.Clear();
+
+    if (argc != 4) {
+        printUsage();
+        return 1;
+    }
+
+    const std::string command = argv[1];
+    if (command == "pack")
+        return pack(argv[2], argv[3]);
+    if (command == "unpack")
+        return unpack(argv[2], argv[3]);
+
+    printUsage();
+    return 1;
+}
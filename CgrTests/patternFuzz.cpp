@@ -0,0 +1,183 @@
+// Differential test for the pattern scanner: Find, FindAll and PatternBatch
+// against a brute-force matcher, over random patterns and buffers. Matches
+// are planted around 16-byte blocks, buffer ends and the chunks a threaded
+// PatternBatch::Scan splits the range into.
+
+#include "Memory/PatternScanner.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+    std::mt19937 rng;
+
+    size_t randomIndex(size_t count) {
+        return std::uniform_int_distribution<size_t>(0, count - 1)(rng);
+    }
+
+    // Wildcards are 0 in Bytes, like the parsed patterns have them.
+    mem::Pattern randomPattern() {
+        mem::Pattern pattern;
+        const size_t size = 1 + randomIndex(40);
+        // Sometimes mostly wildcards, sometimes none at all.
+        const size_t wildcardChance = randomIndex(4) == 0 ? 0 : randomIndex(90);
+        for (size_t i = 0; i < size; ++i) {
+            const bool wildcard = randomIndex(100) < wildcardChance;
+            // Few values, so there are many near misses.
+            pattern.Bytes.push_back(wildcard ? 0x00 : static_cast<uint8_t>(randomIndex(4)));
+            pattern.Mask.push_back(wildcard ? 0x00 : 0xFF);
+        }
+        while (pattern.Anchor < size && pattern.Mask[pattern.Anchor] == 0x00)
+            ++pattern.Anchor;
+        return pattern;
+    }
+
+    void fillRandom(std::vector<uint8_t>& buffer) {
+        for (auto& byte : buffer)
+            byte = static_cast<uint8_t>(randomIndex(4));
+    }
+
+    // Writes a match of pattern at offset, random bytes in its wildcards.
+    void plant(const mem::Pattern& pattern, std::vector<uint8_t>& buffer, size_t offset) {
+        if (offset + pattern.Size() > buffer.size())
+            return;
+        for (size_t i = 0; i < pattern.Size(); ++i) {
+            buffer[offset + i] = pattern.Mask[i] ? pattern.Bytes[i] : static_cast<uint8_t>(rng());
+        }
+    }
+
+    // Offsets next to a boundary, where a match starts or ends.
+    void plantAround(const mem::Pattern& pattern, std::vector<uint8_t>& buffer, size_t boundary) {
+        const size_t offsets[] = {
+            boundary, boundary + 1, boundary - 1,
+            boundary - pattern.Size(), boundary - pattern.Size() + 1,
+        };
+        const size_t offset = offsets[randomIndex(5)];
+        if (offset < buffer.size())
+            plant(pattern, buffer, offset);
+    }
+
+    // Every offset, every byte. Stops after the first match unless all.
+    std::vector<uintptr_t> referenceFind(const mem::Pattern& pattern, const uint8_t* start, size_t size, bool all) {
+        std::vector<uintptr_t> results;
+        if (!pattern.Valid() || pattern.Size() > size)
+            return results;
+        for (size_t offset = 0; offset + pattern.Size() <= size; ++offset) {
+            bool match = true;
+            for (size_t i = 0; i < pattern.Size() && match; ++i) {
+                match = (start[offset + i] & pattern.Mask[i]) == pattern.Bytes[i];
+            }
+            if (!match)
+                continue;
+            results.push_back(reinterpret_cast<uintptr_t>(start + offset));
+            if (!all)
+                break;
+        }
+        return results;
+    }
+
+    size_t failures = 0;
+
+    // Addresses are printed as offsets into the buffer, -1 for not found.
+    void fail(unsigned seed, size_t round, const char* what, const uint8_t* start, uintptr_t expected, uintptr_t actual) {
+        const auto offset = [start](uintptr_t address) {
+            return address ? static_cast<long long>(address - reinterpret_cast<uintptr_t>(start)) : -1LL;
+        };
+        ++failures;
+        printf("seed %u round %zu: %s expected %lld, got %lld\n", seed, round, what, offset(expected), offset(actual));
+    }
+
+    // Single patterns, small buffers at every alignment.
+    void fuzzFind(unsigned seed, size_t rounds) {
+        std::vector<uint8_t> storage;
+        for (size_t round = 0; round < rounds; ++round) {
+            const mem::Pattern pattern = randomPattern();
+            const size_t size = randomIndex(300);
+            const size_t misalign = randomIndex(16);
+            storage.assign(size + misalign, 0);
+            std::vector<uint8_t> buffer(size);
+            fillRandom(buffer);
+            for (size_t i = randomIndex(4); i > 0 && size > 0; --i) {
+                plantAround(pattern, buffer, 16 * randomIndex(size / 16 + 1));
+            }
+            if (size > 0 && randomIndex(2) == 0) {
+                plantAround(pattern, buffer, size);
+            }
+            std::copy(buffer.begin(), buffer.end(), storage.begin() + misalign);
+            const uint8_t* start = storage.data() + misalign;
+
+            const auto expected = referenceFind(pattern, start, size, true);
+            const auto actual = mem::FindAll(pattern, start, size);
+            if (expected != actual) {
+                ++failures;
+                printf("seed %u round %zu: FindAll expected %zu matches, got %zu\n",
+                    seed, round, expected.size(), actual.size());
+            }
+
+            const uintptr_t first = expected.empty() ? 0 : expected.front();
+            const uintptr_t found = mem::Find(pattern, start, size);
+            if (found != first) {
+                fail(seed, round, "Find", start, first, found);
+            }
+        }
+    }
+
+    // Many patterns at once, over buffers big enough to be split over threads.
+    void fuzzBatch(unsigned seed, size_t rounds) {
+        constexpr size_t bufferSize = 4 * 1024 * 1024 + 13;
+        std::vector<uint8_t> buffer(bufferSize);
+        for (size_t round = 0; round < rounds; ++round) {
+            // Random bytes outside the pattern alphabet, so the planted matches
+            // are most of what there is to find.
+            for (auto& byte : buffer)
+                byte = static_cast<uint8_t>(4 + randomIndex(252));
+
+            const unsigned threads = 1 + static_cast<unsigned>(randomIndex(8));
+            const size_t chunks = std::min<size_t>(threads, bufferSize / (1024 * 1024));
+            const size_t chunkSize = bufferSize / chunks;
+
+            std::vector<mem::Pattern> patterns(1 + randomIndex(40));
+            mem::PatternBatch batch;
+            for (auto& pattern : patterns) {
+                pattern = randomPattern();
+                batch.Add(pattern);
+                for (size_t chunk = 1; chunk < chunks; ++chunk) {
+                    if (randomIndex(2) == 0)
+                        plantAround(pattern, buffer, chunk * chunkSize);
+                }
+                if (randomIndex(4) == 0)
+                    plantAround(pattern, buffer, bufferSize);
+                if (randomIndex(4) == 0)
+                    plant(pattern, buffer, randomIndex(bufferSize));
+            }
+
+            batch.Scan(buffer.data(), bufferSize, threads);
+            for (size_t id = 0; id < patterns.size(); ++id) {
+                const auto first = referenceFind(patterns[id], buffer.data(), bufferSize, false);
+                const uintptr_t expected = first.empty() ? 0 : first.front();
+                const uintptr_t found = mem::Find(patterns[id], buffer.data(), bufferSize);
+                if (found != expected) {
+                    fail(seed, round, "Find (big buffer)", buffer.data(), expected, found);
+                }
+                if (batch.Get(id) != expected) {
+                    fail(seed, round, "PatternBatch", buffer.data(), expected, batch.Get(id));
+                }
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const unsigned seed = argc > 1 ? static_cast<unsigned>(strtoul(argv[1], nullptr, 10)) : std::random_device{}();
+    const size_t rounds = argc > 2 ? strtoul(argv[2], nullptr, 10) : 20000;
+    rng.seed(seed);
+
+    fuzzFind(seed, rounds);
+    fuzzBatch(seed, std::max<size_t>(1, rounds / 4000));
+
+    printf("seed %u: %zu rounds, %zu failures\n", seed, rounds, failures);
+    return failures == 0 ? 0 : 1;
+}
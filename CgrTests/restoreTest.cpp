@@ -0,0 +1,241 @@
+// Tests for restoring managed gears: RestoreQueue on its own and fed from
+// another thread, like a hook on the game's gear writes would, and
+// GearManager::Restore with GearsEqual against SimWorld vehicles.
+
+#include "nativeStandin.h"
+#include "simWorld.h"
+
+#include "configIndex.h"
+#include "gearManager.h"
+#include "Memory/VehicleExtensions.hpp"
+#include "Memory/Versions.h"
+#include "Util/Logger.hpp"
+#include "Util/RestoreQueue.h"
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+    size_t failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            ++failures; \
+            printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+        } \
+    } while (false)
+
+    // Stands in for a detour on the game's gear writes: pushes handles from
+    // its own thread whenever the game would have changed them.
+    class StubHookSource {
+    public:
+        StubHookSource(RestoreQueue& queue, std::vector<int> handles, int rounds)
+            : mThread([&queue, handles, rounds] {
+                for (int round = 0; round < rounds; ++round) {
+                    for (int handle : handles)
+                        queue.Push(handle);
+                }
+            }) {}
+        ~StubHookSource() { mThread.join(); }
+
+    private:
+        std::thread mThread;
+    };
+
+    void testQueueOrder() {
+        RestoreQueue queue;
+        CHECK(queue.Empty());
+        queue.Push(3);
+        queue.Push(1);
+        queue.Push(3);
+        queue.Push(2);
+        CHECK(!queue.Empty());
+
+        std::vector<int> dispatched;
+        CHECK(queue.Dispatch([&](int handle) { dispatched.push_back(handle); }) == 3);
+        CHECK((dispatched == std::vector<int>{ 3, 1, 2 }));
+        CHECK(queue.Empty());
+        CHECK(queue.Dispatch([](int) {}) == 0);
+    }
+
+    void testQueuePushDuringDispatch() {
+        RestoreQueue queue;
+        queue.Push(1);
+        size_t calls = 0;
+        queue.Dispatch([&](int handle) {
+            ++calls;
+            queue.Push(handle);
+        });
+        CHECK(calls == 1);
+        // Waits for the next dispatch, instead of looping.
+        CHECK(!queue.Empty());
+        CHECK(queue.Dispatch([](int) {}) == 1);
+
+        queue.Push(5);
+        queue.Clear();
+        CHECK(queue.Empty());
+    }
+
+    void testQueueFromHookThreads() {
+        RestoreQueue queue;
+        std::vector<int> handlesA;
+        std::vector<int> handlesB;
+        for (int handle = 1; handle <= 200; ++handle) {
+            (handle % 2 ? handlesA : handlesB).push_back(handle);
+        }
+
+        std::vector<int> counts(201, 0);
+        bool duplicateInDispatch = false;
+        std::vector<int> seen(201, 0);
+        int dispatch = 0;
+        auto dispatchAll = [&] {
+            ++dispatch;
+            queue.Dispatch([&](int handle) {
+                duplicateInDispatch |= seen[handle] == dispatch;
+                seen[handle] = dispatch;
+                ++counts[handle];
+            });
+        };
+
+        {
+            StubHookSource hookA(queue, handlesA, 500);
+            StubHookSource hookB(queue, handlesB, 500);
+            for (int i = 0; i < 1000; ++i)
+                dispatchAll();
+        }
+        dispatchAll();
+
+        CHECK(!duplicateInDispatch);
+        CHECK(queue.Empty());
+        for (int handle = 1; handle <= 200; ++handle) {
+            CHECK(counts[handle] >= 1);
+        }
+    }
+
+    const SimWorld::Stock sixSpeed = {
+        6, 50.0f, GearSet(std::array<float, 7>{ -3.5f, 3.5f, 2.1f, 1.4f, 1.0f, 0.8f, 0.65f }.data(), 7),
+    };
+
+    const SimWorld::Stock singleSpeed = {
+        1, 40.0f, GearSet(std::array<float, 2>{ -3.3f, 3.3f }.data(), 2),
+    };
+
+    void testGearsEqual(SimWorld& world) {
+        const Vehicle vehicle = world.Spawn(1, "GEARSEQ", sixSpeed);
+        VehicleView view(world.Address(vehicle));
+        const GearSet& ratios = sixSpeed.Ratios;
+        const uint8_t count = static_cast<uint8_t>(ratios.size());
+
+        CHECK(view.GearsEqual(6, 50.0f, ratios.data(), count));
+        CHECK(!view.GearsEqual(5, 50.0f, ratios.data(), count));
+        CHECK(!view.GearsEqual(6, 51.0f, ratios.data(), count));
+
+        // Every position, also past the first four the SSE2 path compares.
+        for (uint8_t gear = 0; gear < count; ++gear) {
+            float* ratio = view.GetGearRatioPtr(gear);
+            const float stock = *ratio;
+            *ratio += 0.5f;
+            CHECK(!view.GearsEqual(6, 50.0f, ratios.data(), count));
+            CHECK(view.GearsEqual(6, 50.0f, ratios.data(), gear));
+            *ratio = stock;
+        }
+        world.Despawn(vehicle);
+    }
+
+    void testRestore(SimWorld& world) {
+        const std::vector<GearInfo> configs;
+        ConfigIndex index;
+        index.Build(configs);
+        GearManager manager(world, configs, index);
+        std::vector<Vehicle> restored;
+        manager.SetRestoreCallback([&](Vehicle vehicle, const ManagedGears&) { restored.push_back(vehicle); });
+
+        const Vehicle car = world.Spawn(2, "RESTORE", sixSpeed);
+        const Vehicle cvt = world.Spawn(3, "CVT", singleSpeed);
+        CHECK(manager.Manage(car));
+        CHECK(manager.Manage(cvt));
+        VehicleView carView(world.Address(car));
+        VehicleView cvtView(world.Address(cvt));
+
+        // Nothing changed, nothing to do.
+        manager.Restore(car);
+        CHECK(restored.empty());
+
+        // The game changes a gear: put back within the same Restore.
+        *carView.GetGearRatioPtr(2) = 9.0f;
+        manager.Restore(car);
+        CHECK(restored.size() == 1);
+        CHECK(*carView.GetGearRatioPtr(2) == sixSpeed.Ratios[2]);
+        manager.Restore(car);
+        CHECK(restored.size() == 1);
+
+        // The top gear's own ratio counts too.
+        *carView.GetGearRatioPtr(sixSpeed.TopGear) = 0.5f;
+        manager.Restore(car);
+        CHECK(restored.size() == 2);
+        CHECK(*carView.GetGearRatioPtr(sixSpeed.TopGear) == sixSpeed.Ratios[sixSpeed.TopGear]);
+
+        // The CVT drives gear 1 of single-gear vehicles, that's left alone.
+        *cvtView.GetGearRatioPtr(1) = 1.7f;
+        for (int tick = 0; tick < 10; ++tick)
+            manager.Restore(cvt);
+        CHECK(restored.size() == 2);
+        CHECK(*cvtView.GetGearRatioPtr(1) == 1.7f);
+        // Anything else on it is still restored.
+        cvtView.SetDriveMaxFlatVel(60.0f);
+        manager.Restore(cvt);
+        CHECK(restored.size() == 3);
+        CHECK(cvtView.GetDriveMaxFlatVel() == singleSpeed.DriveMaxVel);
+
+        // A vehicle that isn't the player's, reported by a hook instead of
+        // the per-tick check.
+        world.Tune(car);
+        {
+            RestoreQueue& hookQueue = manager.RestoreRequests();
+            StubHookSource hook(hookQueue, { car }, 1);
+        }
+        manager.Restore(0);
+        CHECK(restored.size() == 4 && restored.back() == car);
+        CHECK(carView.GearsEqual(sixSpeed.TopGear, sixSpeed.DriveMaxVel,
+            sixSpeed.Ratios.data(), static_cast<uint8_t>(sixSpeed.Ratios.size())));
+
+        // Reapply passes count apart from the restores above.
+        CHECK(manager.Stats().TotalImmediate == 4);
+        CHECK(manager.Stats().TotalRestored == 0);
+        *carView.GetGearRatioPtr(3) = 9.0f;
+        manager.Reapply(true);
+        CHECK(manager.Stats().Checked == 2);
+        CHECK(manager.Stats().Restored == 1);
+        CHECK(manager.Stats().TotalRestored == 1);
+        CHECK(manager.Stats().TotalImmediate == 4);
+
+        world.Despawn(car);
+        world.Despawn(cvt);
+    }
+}
+
+int main() {
+    logger.SetFile("CgrRestoreTest.log");
+    logger.Clear();
+
+    testQueueOrder();
+    testQueuePushDuringDispatch();
+    testQueueFromHookThreads();
+
+    SimWorld world(16, 0xC0FFEE);
+    const std::vector<uint8_t> module = world.ModuleImage(1024 * 1024);
+    Standin::SetModule(module.data(), module.size());
+    Standin::SetWorld(&world);
+    VehicleExtensions::SetVersion(G_VER_1_0_1604_0_STEAM);
+    VehicleExtensions::Init();
+
+    testGearsEqual(world);
+    testRestore(world);
+
+    logger.Close();
+    printf("%zu failures\n", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -1,28 +1,116 @@
 #include "NativeMemory.hpp"
+#include "PatternScanner.hpp"
 
 #include "../Util/Logger.hpp"
+#include "../Util/Trace.h"
 #include <Windows.h>
 #include <Psapi.h>
-#include <sstream>
+#include <simpleini/SimpleIni.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <utility>
 
 #include "inc/main.h"
 
 namespace {
-    template<typename Out>
-    void split(const std::string& s, char delim, Out result) {
-        std::stringstream ss;
-        ss.str(s);
-        std::string item;
-        while (std::getline(ss, item, delim)) {
-            *(result++) = item;
+    std::pair<const uint8_t*, size_t> getModuleRange() {
+        MODULEINFO modInfo{};
+        GetModuleInformation(GetCurrentProcess(), GetModuleHandle(nullptr), &modInfo, sizeof(MODULEINFO));
+
+        return { static_cast<const uint8_t*>(modInfo.lpBaseOfDll),
+                 static_cast<size_t>(modInfo.SizeOfImage) };
+    }
+
+    SVersion g_exeVersion{ 0, 0 };
+
+    // Changes with any game build, but also with any change to our patterns.
+    std::string getCacheKey(const mem::PatternBatch& batch, const uint8_t* base, size_t size) {
+        const auto dosHeader = reinterpret_cast<const IMAGE_DOS_HEADER*>(base);
+        const auto ntHeaders = reinterpret_cast<const IMAGE_NT_HEADERS*>(base + dosHeader->e_lfanew);
+
+        char key[96];
+        snprintf(key, sizeof(key), "%d.%d-%08X-%08X-%016llX",
+            g_exeVersion.Minor, g_exeVersion.Build,
+            static_cast<unsigned>(size), static_cast<unsigned>(ntHeaders->FileHeader.TimeDateStamp),
+            static_cast<unsigned long long>(batch.Fingerprint()));
+        return key;
+    }
+
+    // Results are stored relative to the module base, 0 for not found.
+    bool loadCache(mem::PatternBatch& batch, const std::string& file, const uint8_t* base, size_t size) {
+        CSimpleIniA cache;
+        cache.SetUnicode();
+        if (cache.LoadFile(file.c_str()) < 0)
+            return false;
+
+        const std::string key = getCacheKey(batch, base, size);
+        if (key != cache.GetValue("CACHE", "Key", "")) {
+            logger.Write(INFO, "Offset cache is for a different game build or mod version");
+            return false;
+        }
+
+        std::vector<uintptr_t> results(batch.Count());
+        for (size_t id = 0; id < results.size(); ++id) {
+            const long offset = cache.GetLongValue("OFFSETS", std::to_string(id).c_str(), -1);
+            if (offset < 0) {
+                logger.Write(WARN, "Offset cache incomplete");
+                return false;
+            }
+            results[id] = offset == 0 ? 0 : reinterpret_cast<uintptr_t>(base) + offset;
         }
+
+        if (!batch.Restore(results, base, size)) {
+            logger.Write(WARN, "Offset cache doesn't match game code");
+            return false;
+        }
+        return true;
     }
 
-    std::vector<std::string> split(const std::string& s, char delim) {
-        std::vector<std::string> elems;
-        ::split(s, delim, std::back_inserter(elems));
-        return elems;
+    void saveCache(const mem::PatternBatch& batch, const std::string& file, const uint8_t* base, size_t size) {
+        CSimpleIniA cache;
+        cache.SetUnicode();
+        cache.SetValue("CACHE", "Key", getCacheKey(batch, base, size).c_str());
+
+        for (size_t id = 0; id < batch.Count(); ++id) {
+            const uintptr_t addr = batch.Get(id);
+            const long offset = addr == 0 ? 0 : static_cast<long>(addr - reinterpret_cast<uintptr_t>(base));
+            cache.SetLongValue("OFFSETS", std::to_string(id).c_str(), offset, nullptr, true);
+        }
+
+        if (cache.SaveFile(file.c_str()) < 0) {
+            logger.Write(WARN, "Couldn't write offset cache to %s", file.c_str());
+        }
     }
+
+    double msSince(std::chrono::steady_clock::time_point start) {
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() / 1000.0;
+    }
+
+    constexpr auto getAddressOfEntityPattern = mem::MakePattern(
+        "\x83\xF9\xFF\x74\x31\x4C\x8B\x0D\x00\x00\x00\x00\x44\x8B\xC1\x49\x8B\x41\x08",
+        "xxxxxxxx????xxxxxxx");
+
+    constexpr auto getModelInfoPattern = mem::MakePattern(
+        "\x0F\xB7\x05\x00\x00\x00\x00"
+        "\x45\x33\xC9\x4C\x8B\xDA\x66\x85\xC0"
+        "\x0F\x84\x00\x00\x00\x00"
+        "\x44\x0F\xB7\xC0\x33\xD2\x8B\xC1\x41\xF7\xF0\x48"
+        "\x8B\x05\x00\x00\x00\x00"
+        "\x4C\x8B\x14\xD0\xEB\x09\x41\x3B\x0A\x74\x54",
+        "xxx????"
+        "xxxxxxxxx"
+        "xx????"
+        "xxxxxxxxxxxx"
+        "xx????"
+        "xxxxxxxxxxx");
+
+    constexpr auto getModelInfoPattern58 = mem::MakePattern("\xEB\x09\x41\x3B\x0A\x74\x54", "xxxxxxx");
+
+    size_t getAddressOfEntityId = 0;
+    size_t getModelInfoId = 0;
 }
 
 extern eGameVersion g_gameVersion;
@@ -33,32 +121,35 @@ namespace mem {
     uintptr_t(*GetModelInfo)(unsigned int modelHash, int* index) = nullptr;
 
     void init() {
-        auto addr = FindPattern("\x83\xF9\xFF\x74\x31\x4C\x8B\x0D\x00\x00\x00\x00\x44\x8B\xC1\x49\x8B\x41\x08",
-                                                            "xxxxxxxx????xxxxxxx");
+        PatternBatch batch;
+        initPatterns(batch);
+        ScanModule(batch);
+        initResolve(batch);
+    }
+
+    void initPatterns(PatternBatch& batch) {
+        getAddressOfEntityId = batch.Add(getAddressOfEntityPattern);
+
+        if (g_gameVersion < 58) {
+            getModelInfoId = batch.Add(getModelInfoPattern);
+        }
+        else {
+            getModelInfoId = batch.Add(getModelInfoPattern58);
+        }
+    }
+
+    void initResolve(const PatternBatch& batch) {
+        auto addr = batch.Get(getAddressOfEntityId);
         if (!addr) logger.Write(ERROR, "Couldn't find GetAddressOfEntity");
         GetAddressOfEntity = reinterpret_cast<uintptr_t(*)(int)>(addr);
 
+        addr = batch.Get(getModelInfoId);
         if (g_gameVersion < 58) {
-            addr = FindPattern(
-                "\x0F\xB7\x05\x00\x00\x00\x00"
-                "\x45\x33\xC9\x4C\x8B\xDA\x66\x85\xC0"
-                "\x0F\x84\x00\x00\x00\x00"
-                "\x44\x0F\xB7\xC0\x33\xD2\x8B\xC1\x41\xF7\xF0\x48"
-                "\x8B\x05\x00\x00\x00\x00"
-                "\x4C\x8B\x14\xD0\xEB\x09\x41\x3B\x0A\x74\x54",
-                "xxx????"
-                "xxxxxxxxx"
-                "xx????"
-                "xxxxxxxxxxxx"
-                "xx????"
-                "xxxxxxxxxxx");
-
             if (!addr) {
                 logger.Write(ERROR, "Couldn't find GetModelInfo");
             }
         }
         else {
-            addr = FindPattern("\xEB\x09\x41\x3B\x0A\x74\x54", "xxxxxxx");
             if (!addr) {
                 logger.Write(ERROR, "Couldn't find GetModelInfo (v58+)");
             }
@@ -68,77 +159,52 @@ namespace mem {
         GetModelInfo = reinterpret_cast<uintptr_t(*)(unsigned int modelHash, int* index)>(addr);
     }
 
-    uintptr_t FindPattern(const char* pattern, const char* mask) {
-        MODULEINFO modInfo = { nullptr };
-        GetModuleInformation(GetCurrentProcess(), GetModuleHandle(nullptr), &modInfo, sizeof(MODULEINFO));
-
-        const char* start_offset = reinterpret_cast<const char *>(modInfo.lpBaseOfDll);
-        const uintptr_t size = static_cast<uintptr_t>(modInfo.SizeOfImage);
-
-        intptr_t pos = 0;
-        const uintptr_t searchLen = static_cast<uintptr_t>(strlen(mask) - 1);
-
-        for (const char* retAddress = start_offset; retAddress < start_offset + size; retAddress++) {
-            if (*retAddress == pattern[pos] || mask[pos] == '?') {
-                if (mask[pos + 1] == '\0')
-                    return (reinterpret_cast<uintptr_t>(retAddress) - searchLen);
-                pos++;
-            }
-            else {
-                pos = 0;
-            }
-        }
-        return 0;
+    void SetExeVersion(SVersion exeVersion) {
+        g_exeVersion = exeVersion;
     }
 
-    std::vector<uintptr_t> FindPatterns(const char* pattern, const char* mask) {
-        std::vector <uintptr_t> addresses;
-
-        MODULEINFO modInfo = { nullptr };
-        GetModuleInformation(GetCurrentProcess(), GetModuleHandle(nullptr), &modInfo, sizeof(MODULEINFO));
+    void ScanModule(PatternBatch& batch, const std::string& cacheFile) {
+        TRACE_SCOPE("ScanModule");
+        const auto range = getModuleRange();
+        const auto start = std::chrono::steady_clock::now();
 
-        const char* start_offset = reinterpret_cast<const char *>(modInfo.lpBaseOfDll);
-        const uintptr_t size = static_cast<uintptr_t>(modInfo.SizeOfImage);
+        if (!cacheFile.empty() && loadCache(batch, cacheFile, range.first, range.second)) {
+            logger.Write(INFO, "Restored %u patterns from offset cache in %.3f ms",
+                static_cast<unsigned>(batch.Count()), msSince(start));
+            return;
+        }
 
-        intptr_t pos = 0;
-        const uintptr_t searchLen = static_cast<uintptr_t>(strlen(mask) - 1);
+        // Scanning is read-only, so split it over a few threads. All of them are
+        // joined before Scan returns, so results are complete once published.
+        const unsigned threads = std::max(1u, std::min(std::thread::hardware_concurrency(), 4u));
+        batch.Scan(range.first, range.second, threads);
+        logger.Write(INFO, "Scanned for %u patterns in %.3f ms (%u threads)",
+            static_cast<unsigned>(batch.Count()), msSince(start), threads);
 
-        for (const char* retAddress = start_offset; retAddress < start_offset + size; retAddress++) {
-            if (*retAddress == pattern[pos] || mask[pos] == '?') {
-                if (mask[pos + 1] == '\0')
-                    addresses.push_back(reinterpret_cast<uintptr_t>(retAddress) - searchLen);
-                pos++;
-            }
-            else {
-                pos = 0;
-            }
+        if (!cacheFile.empty()) {
+            saveCache(batch, cacheFile, range.first, range.second);
         }
-        return addresses;
     }
 
-uintptr_t FindPattern(const char* pattStr) {
-    std::vector<std::string> bytesStr = split(pattStr, ' ');
+    uintptr_t FindPattern(const char* pattern, const char* mask) {
+        return FindPattern(Pattern(pattern, mask));
+    }
 
-    MODULEINFO modInfo{};
-    GetModuleInformation(GetCurrentProcess(), GetModuleHandle(nullptr), &modInfo, sizeof(MODULEINFO));
+    uintptr_t FindPattern(const char* pattStr) {
+        return FindPattern(Pattern(pattStr));
+    }
 
-    auto* start_offset = static_cast<uint8_t*>(modInfo.lpBaseOfDll);
-    const auto size = static_cast<uintptr_t>(modInfo.SizeOfImage);
+    uintptr_t FindPattern(PatternView pattern) {
+        const auto range = getModuleRange();
+        return Find(pattern, range.first, range.second);
+    }
 
-    uintptr_t pos = 0;
-    const uintptr_t searchLen = bytesStr.size();
+    std::vector<uintptr_t> FindPatterns(const char* pattern, const char* mask) {
+        return FindPatterns(Pattern(pattern, mask));
+    }
 
-    for (auto* retAddress = start_offset; retAddress < start_offset + size; retAddress++) {
-        if (bytesStr[pos] == "??" || bytesStr[pos] == "?" || 
-            *retAddress == static_cast<uint8_t>(std::strtoul(bytesStr[pos].c_str(), nullptr, 16))) {
-            if (pos + 1 == bytesStr.size())
-                return (reinterpret_cast<uintptr_t>(retAddress) - searchLen + 1);
-            pos++;
-        }
-        else {
-            pos = 0;
-        }
+    std::vector<uintptr_t> FindPatterns(PatternView pattern) {
+        const auto range = getModuleRange();
+        return FindAll(pattern, range.first, range.second);
     }
-    return 0;
-}
 }
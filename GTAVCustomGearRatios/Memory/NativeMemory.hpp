@@ -1,12 +1,28 @@
 #pragma once
+#include "../Util/FileVersion.h"
 #include <cstdint>
+#include <string>
 #include <vector>
 
 namespace mem {
+class PatternBatch;
+struct PatternView;
+
 void init();
+// Split init(), so its patterns can share a single scan with others.
+void initPatterns(PatternBatch& batch);
+void initResolve(const PatternBatch& batch);
+// Part of the offset cache key, see ScanModule.
+void SetExeVersion(SVersion exeVersion);
+// Resolves all patterns in the batch against the game module.
+// With a cache file, results are stored per game build and restored on later
+// starts instead of scanning. Cached matches are checked before use.
+void ScanModule(PatternBatch& batch, const std::string& cacheFile = {});
 uintptr_t FindPattern(const char* pattern, const char* mask); 
 uintptr_t FindPattern(const char* pattStr);
+uintptr_t FindPattern(PatternView pattern);
 std::vector<uintptr_t> FindPatterns(const char* pattern, const char* mask);
+std::vector<uintptr_t> FindPatterns(PatternView pattern);
 extern uintptr_t(*GetAddressOfEntity)(int entity);
 extern uintptr_t(*GetModelInfo)(unsigned int modelHash, int* index);
 }
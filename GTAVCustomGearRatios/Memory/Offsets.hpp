@@ -206,6 +206,8 @@ const struct CVehicleHandlingData_1604 {
 
 } hOffsets1604 = {};
 
+// Layout notes, in MSVC types. Only the offsets above are used.
+#ifdef _MSC_VER
 // 1032
 const struct CWheel {
     // Wheel stuff:
@@ -367,3 +369,4 @@ public:
 };                                                          // Size=0x18D4
 
 //1103
+#endif
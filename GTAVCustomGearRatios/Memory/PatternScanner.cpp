@@ -0,0 +1,302 @@
+#include "PatternScanner.hpp"
+
+#include "../Util/Trace.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <utility>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#define MEM_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace {
+    size_t findAnchor(const std::vector<uint8_t>& mask) {
+        size_t i = 0;
+        while (i < mask.size() && mask[i] == 0x00)
+            ++i;
+        return i;
+    }
+
+#ifdef MEM_SSE2
+    uint32_t lowestBit(uint32_t bits) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, bits);
+        return index;
+#else
+        return static_cast<uint32_t>(__builtin_ctz(bits));
+#endif
+    }
+#endif
+
+    // Calls onMatch(address) for every match, in order, until it returns false.
+    template <typename F>
+    void scan(mem::PatternView pattern, const uint8_t* start, size_t size, F onMatch) {
+        if (!pattern.Valid() || pattern.Size > size)
+            return;
+
+        // Range the anchor byte of a full match can be in.
+        const uint8_t* curr = start + pattern.Anchor;
+        const uint8_t* last = start + (size - pattern.Size) + pattern.Anchor;
+        const uint8_t anchor = pattern.Bytes[pattern.Anchor];
+
+#ifdef MEM_SSE2
+        const __m128i needle = _mm_set1_epi8(static_cast<char>(anchor));
+        while (last - curr >= 15) {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(curr));
+            uint32_t hits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+            while (hits != 0) {
+                const uint8_t* candidate = curr + lowestBit(hits) - pattern.Anchor;
+                if (pattern.Matches(candidate) && !onMatch(reinterpret_cast<uintptr_t>(candidate)))
+                    return;
+                hits &= hits - 1;
+            }
+            curr += 16;
+        }
+#endif
+        for (; curr <= last; ++curr) {
+            if (*curr != anchor)
+                continue;
+            const uint8_t* candidate = curr - pattern.Anchor;
+            if (pattern.Matches(candidate) && !onMatch(reinterpret_cast<uintptr_t>(candidate)))
+                return;
+        }
+    }
+}
+
+namespace mem {
+    Pattern::Pattern(const char* pattern, const char* mask) {
+        const size_t size = strlen(mask);
+        Bytes.resize(size);
+        Mask.resize(size);
+        for (size_t i = 0; i < size; ++i) {
+            const bool wildcard = mask[i] == '?';
+            Bytes[i] = wildcard ? 0x00 : static_cast<uint8_t>(pattern[i]);
+            Mask[i] = wildcard ? 0x00 : 0xFF;
+        }
+        Anchor = findAnchor(Mask);
+    }
+
+    Pattern::Pattern(const char* pattStr) {
+        const char* c = pattStr;
+        while (*c != '\0') {
+            if (*c == ' ') {
+                ++c;
+                continue;
+            }
+
+            if (*c == '?') {
+                Bytes.push_back(0x00);
+                Mask.push_back(0x00);
+                while (*c == '?')
+                    ++c;
+                continue;
+            }
+
+            char* end = nullptr;
+            Bytes.push_back(static_cast<uint8_t>(strtoul(c, &end, 16)));
+            Mask.push_back(0xFF);
+            // Don't get stuck on garbage
+            c = end == c ? c + 1 : end;
+        }
+        Anchor = findAnchor(Mask);
+    }
+
+    Pattern::Pattern(PatternView view)
+        : Bytes(view.Bytes, view.Bytes + view.Size)
+        , Mask(view.Mask, view.Mask + view.Size)
+        , Anchor(view.Anchor) {}
+
+    bool PatternView::Matches(const uint8_t* address) const {
+        size_t i = 0;
+#ifdef MEM_SSE2
+        for (; i + 16 <= Size; i += 16) {
+            const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(address + i));
+            const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Mask + i));
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Bytes + i));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(data, mask), bytes)) != 0xFFFF)
+                return false;
+        }
+#endif
+        for (; i < Size; ++i) {
+            if ((address[i] & Mask[i]) != Bytes[i])
+                return false;
+        }
+        return true;
+    }
+
+    uintptr_t Find(PatternView pattern, const uint8_t* start, size_t size) {
+        uintptr_t result = 0;
+        scan(pattern, start, size, [&](uintptr_t address) {
+            result = address;
+            return false;
+        });
+        return result;
+    }
+
+    std::vector<uintptr_t> FindAll(PatternView pattern, const uint8_t* start, size_t size) {
+        std::vector<uintptr_t> results;
+        scan(pattern, start, size, [&](uintptr_t address) {
+            results.push_back(address);
+            return true;
+        });
+        return results;
+    }
+
+    size_t PatternBatch::Add(PatternView pattern) {
+        mPatterns.emplace_back(pattern);
+        mResults.push_back(0);
+        return mPatterns.size() - 1;
+    }
+
+    size_t PatternBatch::Add(const char* pattern, const char* mask) {
+        mPatterns.emplace_back(pattern, mask);
+        mResults.push_back(0);
+        return mPatterns.size() - 1;
+    }
+
+    size_t PatternBatch::Add(const char* pattStr) {
+        mPatterns.emplace_back(pattStr);
+        mResults.push_back(0);
+        return mPatterns.size() - 1;
+    }
+
+    void PatternBatch::Scan(const uint8_t* start, size_t size, unsigned threads) {
+        // Small ranges aren't worth the thread startup.
+        constexpr size_t minChunkSize = 1024 * 1024;
+        size_t chunks = threads == 0 ? 1 : threads;
+        chunks = std::min(chunks, std::max<size_t>(1, size / minChunkSize));
+
+        if (chunks == 1) {
+            scanChunk(start, size, 0, size, mResults);
+            return;
+        }
+
+        // Chunks split on the match start only. Patterns starting close to the
+        // end of a chunk are still read past it, so nothing on a boundary is lost.
+        const size_t chunkSize = size / chunks;
+        std::vector<std::vector<uintptr_t>> chunkResults(chunks, std::vector<uintptr_t>(mPatterns.size()));
+        std::vector<std::thread> workers;
+        workers.reserve(chunks - 1);
+        for (size_t chunk = 1; chunk < chunks; ++chunk) {
+            const size_t from = chunk * chunkSize;
+            const size_t to = chunk == chunks - 1 ? size : from + chunkSize;
+            workers.emplace_back([this, start, size, from, to, &chunkResults, chunk] {
+                scanChunk(start, size, from, to, chunkResults[chunk]);
+            });
+        }
+        scanChunk(start, size, 0, chunkSize, chunkResults[0]);
+
+        for (auto& worker : workers)
+            worker.join();
+
+        // Earliest chunk with a match has the first match.
+        for (size_t id = 0; id < mPatterns.size(); ++id) {
+            mResults[id] = 0;
+            for (const auto& results : chunkResults) {
+                if (results[id] != 0) {
+                    mResults[id] = results[id];
+                    break;
+                }
+            }
+        }
+    }
+
+    void PatternBatch::scanChunk(const uint8_t* start, size_t size, size_t from, size_t to,
+                                 std::vector<uintptr_t>& results) const {
+        TRACE_SCOPE("ScanChunk");
+        // Unresolved patterns, bucketed by the value of their anchor byte.
+        std::array<std::vector<size_t>, 256> buckets;
+        size_t remaining = 0;
+        size_t maxAnchor = 0;
+        for (size_t id = 0; id < mPatterns.size(); ++id) {
+            results[id] = 0;
+            const Pattern& pattern = mPatterns[id];
+            if (!pattern.Valid() || pattern.Size() > size)
+                continue;
+            buckets[pattern.Bytes[pattern.Anchor]].push_back(id);
+            maxAnchor = std::max(maxAnchor, pattern.Anchor);
+            ++remaining;
+        }
+
+        // Anchor bytes of matches starting in [from, to) can be up to maxAnchor further.
+        const uint8_t* end = start + std::min(size, to + maxAnchor);
+        for (const uint8_t* curr = start + from; curr < end && remaining > 0; ++curr) {
+            auto& bucket = buckets[*curr];
+            for (size_t i = 0; i < bucket.size();) {
+                const PatternView pattern = mPatterns[bucket[i]];
+                const size_t offset = static_cast<size_t>(curr - start);
+
+                if (offset < pattern.Anchor ||
+                    offset - pattern.Anchor < from ||
+                    offset - pattern.Anchor >= to ||
+                    size - (offset - pattern.Anchor) < pattern.Size) {
+                    ++i;
+                    continue;
+                }
+
+                const uint8_t* candidate = curr - pattern.Anchor;
+                if (pattern.Matches(candidate)) {
+                    results[bucket[i]] = reinterpret_cast<uintptr_t>(candidate);
+                    bucket[i] = bucket.back();
+                    bucket.pop_back();
+                    --remaining;
+                    continue;
+                }
+                ++i;
+            }
+        }
+    }
+
+    uintptr_t PatternBatch::Get(size_t id) const {
+        if (id >= mResults.size())
+            return 0;
+        return mResults[id];
+    }
+
+    bool PatternBatch::Restore(const std::vector<uintptr_t>& results, const uint8_t* start, size_t size) {
+        if (results.size() != mPatterns.size())
+            return false;
+
+        const uintptr_t begin = reinterpret_cast<uintptr_t>(start);
+        for (size_t id = 0; id < mPatterns.size(); ++id) {
+            const uintptr_t address = results[id];
+            if (address == 0)
+                continue;
+            if (mPatterns[id].Size() > size || address < begin || address - begin > size - mPatterns[id].Size())
+                return false;
+            if (!PatternView(mPatterns[id]).Matches(reinterpret_cast<const uint8_t*>(address)))
+                return false;
+        }
+        mResults = results;
+        return true;
+    }
+
+    uint64_t PatternBatch::Fingerprint() const {
+        // FNV-1a
+        uint64_t hash = 0xcbf29ce484222325ull;
+        auto hashByte = [&](uint8_t byte) {
+            hash ^= byte;
+            hash *= 0x100000001b3ull;
+        };
+
+        for (const auto& pattern : mPatterns) {
+            for (size_t i = 0; i < pattern.Size(); ++i) {
+                hashByte(pattern.Bytes[i]);
+                hashByte(pattern.Mask[i]);
+            }
+            // Separator, so a split in a different place hashes differently
+            hashByte(0xA5);
+        }
+        return hash;
+    }
+}
@@ -0,0 +1,163 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace mem {
+// Non-owning byte signature with a wildcard mask.
+// Mask is 0xFF for bytes that need to match, 0x00 for wildcards.
+struct PatternView {
+    const uint8_t* Bytes;
+    const uint8_t* Mask;
+    size_t Size;
+    // Index of the first non-wildcard byte.
+    size_t Anchor;
+
+    // False if there's no fixed byte to anchor on.
+    bool Valid() const { return Anchor < Size; }
+    // Caller guarantees Size bytes are readable at address.
+    bool Matches(const uint8_t* address) const;
+};
+
+// Pattern parsed at run time.
+struct Pattern {
+    Pattern() = default;
+    // Code-style: "\x48\x8B\x00", "xx?"
+    Pattern(const char* pattern, const char* mask);
+    // IDA-style: "48 8B ?"
+    explicit Pattern(const char* pattStr);
+    explicit Pattern(PatternView view);
+
+    size_t Size() const { return Bytes.size(); }
+    bool Valid() const { return Anchor < Bytes.size(); }
+    operator PatternView() const { return { Bytes.data(), Mask.data(), Bytes.size(), Anchor }; }
+
+    std::vector<uint8_t> Bytes;
+    std::vector<uint8_t> Mask;
+    size_t Anchor = 0;
+};
+
+// Pattern parsed at compile time, see MakePattern.
+template <size_t N>
+struct StaticPattern {
+    uint8_t Bytes[N]{};
+    uint8_t Mask[N]{};
+    size_t Size = 0;
+    size_t Anchor = 0;
+
+    constexpr operator PatternView() const { return { Bytes, Mask, Size, Anchor }; }
+};
+
+namespace detail {
+    constexpr int hexValue(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        return -1;
+    }
+
+    template <size_t N>
+    constexpr void setAnchor(StaticPattern<N>& pattern) {
+        while (pattern.Anchor < pattern.Size && pattern.Mask[pattern.Anchor] == 0x00)
+            ++pattern.Anchor;
+    }
+}
+
+// IDA-style: "3A 91 ? ? ? ? 74 ? 84 D2".
+// Bind the result to a constexpr variable to have it parsed at build time.
+// Malformed patterns are a compile error then.
+template <size_t L>
+constexpr StaticPattern<(L + 1) / 2> MakePattern(const char (&pattStr)[L]) {
+    StaticPattern<(L + 1) / 2> result{};
+    size_t i = 0;
+    while (i < L - 1) {
+        if (pattStr[i] == ' ') {
+            ++i;
+            continue;
+        }
+
+        if (pattStr[i] == '?') {
+            result.Bytes[result.Size] = 0x00;
+            result.Mask[result.Size] = 0x00;
+            ++result.Size;
+            while (i < L - 1 && pattStr[i] == '?')
+                ++i;
+            continue;
+        }
+
+        if (detail::hexValue(pattStr[i]) < 0)
+            throw std::invalid_argument("Invalid character in pattern");
+
+        unsigned value = 0;
+        while (i < L - 1 && detail::hexValue(pattStr[i]) >= 0) {
+            value = value * 16 + static_cast<unsigned>(detail::hexValue(pattStr[i]));
+            ++i;
+        }
+        result.Bytes[result.Size] = static_cast<uint8_t>(value);
+        result.Mask[result.Size] = 0xFF;
+        ++result.Size;
+    }
+    detail::setAnchor(result);
+    return result;
+}
+
+// Code-style: "\x48\x8B\x00", "xx?".
+template <size_t L, size_t M>
+constexpr StaticPattern<M - 1> MakePattern(const char (&pattern)[L], const char (&mask)[M]) {
+    static_assert(L >= M, "Pattern shorter than mask");
+    StaticPattern<M - 1> result{};
+    for (size_t i = 0; i < M - 1; ++i) {
+        const bool wildcard = mask[i] == '?';
+        result.Bytes[i] = wildcard ? 0x00 : static_cast<uint8_t>(pattern[i]);
+        result.Mask[i] = wildcard ? 0x00 : 0xFF;
+    }
+    result.Size = M - 1;
+    detail::setAnchor(result);
+    return result;
+}
+
+// Address of the first match in [start, start + size), 0 if not found.
+// Candidates for the anchor byte are found 16 bytes at a time (SSE2), then
+// verified with a masked compare.
+uintptr_t Find(PatternView pattern, const uint8_t* start, size_t size);
+
+// All matches in [start, start + size), overlapping ones included.
+std::vector<uintptr_t> FindAll(PatternView pattern, const uint8_t* start, size_t size);
+
+// Collects patterns up-front and resolves all of them in a single pass.
+// Every position is checked only against patterns anchored on its byte value,
+// so the cost is one walk over the range instead of one walk per pattern.
+class PatternBatch {
+public:
+    // Returns an id to look up the result with after Scan.
+    size_t Add(PatternView pattern);
+    size_t Add(const char* pattern, const char* mask);
+    size_t Add(const char* pattStr);
+
+    // Finds the first match of every pattern in [start, start + size).
+    // With more than one thread, the range is split into that many chunks that
+    // are scanned concurrently. Results are the same as a single-threaded scan.
+    void Scan(const uint8_t* start, size_t size, unsigned threads = 1);
+
+    // Address of the first match, 0 if not found.
+    uintptr_t Get(size_t id) const;
+    size_t Count() const { return mPatterns.size(); }
+
+    // Takes results from an earlier Scan (e.g. cached), instead of scanning.
+    // Every non-zero address is checked against its pattern first. Returns false
+    // and leaves the results alone if any of them don't match.
+    bool Restore(const std::vector<uintptr_t>& results, const uint8_t* start, size_t size);
+
+    // Hash over all registered patterns, to tell if cached results still apply.
+    uint64_t Fingerprint() const;
+
+private:
+    // First matches of patterns starting in [start + from, start + to).
+    void scanChunk(const uint8_t* start, size_t size, size_t from, size_t to,
+                   std::vector<uintptr_t>& results) const;
+
+    std::vector<Pattern> mPatterns;
+    std::vector<uintptr_t> mResults;
+};
+}
@@ -1,12 +1,19 @@
 #include "VehicleExtensions.hpp"
 
 #include "NativeMemory.hpp"
+#include "PatternScanner.hpp"
 #include "Versions.h"
 #include "Offsets.hpp"
 #include "../Util/Logger.hpp"
+#include "../Util/Trace.h"
 
 #include <inc/main.h>
 
+#include <algorithm>
+#include <cstring>
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 #include <vector>
 #include <functional>
 
@@ -79,6 +86,51 @@ namespace {
     int wheelMatTypeOffset = 0;
 }
 
+namespace {
+    // Offset patterns, parsed at compile time.
+    constexpr auto rocketBoostActivePattern = mem::MakePattern("3A 91 ? ? ? ? 74 ? 84 D2");
+    constexpr auto rocketBoostChargePattern = mem::MakePattern("\x48\x8B\x47\x00\xF3\x44\x0F\x10\x9F\x00\x00\x00\x00", "xxx?xxxxx????");
+    // Unknown
+    constexpr auto hoverTransformRatioPattern = mem::MakePattern("\xF3\x0F\x11\xB3\x00\x00\x00\x00\x44\x88\x00\x00\x00\x00\x00\x48\x85\xC9",
+        "xxxx????xx?????xxx");
+    constexpr auto fuelLevelPattern = mem::MakePattern("\x74\x26\x0F\x57\xC9", "xxxxx");
+    constexpr auto nextGearPattern = mem::MakePattern("\x48\x8D\x8F\x00\x00\x00\x00\x4C\x8B\xC3\xF3\x0F\x11\x7C\x24",
+        "xxx????xxxxxxxx");
+    constexpr auto driveForcePattern1604 = mem::MakePattern("\xF3\x0F\x10\x8F\xA4\x08\x00\x00\xF3\x0F\x5E\xF0\x41\x0F\x2F\xCA", "xxxx????xxx?xxx?");
+    constexpr auto currentRPMPattern = mem::MakePattern("\x76\x03\x0F\x28\xF0\xF3\x44\x0F\x10\x93",
+        "xxxxxxxxxx");
+    constexpr auto turboPattern1604 = mem::MakePattern("\xF3\x0F\x10\x9F\xD4\x08\x00\x00\x0F\x2F\xDF\x73\x0A", "xxxx????xxxxx");
+    constexpr auto turboPattern = mem::MakePattern("\xF3\x0F\x10\x8F\x68\x08\x00\x00\x88\x4D\x8C\x0F\x2F\xCF",
+        "xxxx????xxx???");
+    constexpr auto handlingPattern = mem::MakePattern("\x3C\x03\x0F\x85\x00\x00\x00\x00\x48\x8B\x41\x20\x48\x8B\x88",
+        "xxxx????xxxxxxx");
+    constexpr auto lightStatesPattern = mem::MakePattern("FD 02 DB 08 98 ? ? ? ? 48 8B 5C 24 30");
+    // Or "8A 96 ? ? ? ? 0F B6 C8 84 D2 41", +10 or something (+31 is the engine starting bit), (0x928 starting addr)
+    // Figuring out indicator timing: LieutenantDan
+    constexpr auto indicatorTimingPattern = mem::MakePattern("\x44\x0F\xB7\x91\xDC\x00\x00\x00\x0F\xB7\x81\xB0\x0A\x00\x00\x41\xB9\x01\x00\x00\x00\x44\x03\x15\x8C\x63\xDF\x01",
+        "xxxx????xxx????xxxxxxxxx????");
+    constexpr auto steeringAngleInputPattern = mem::MakePattern("\x74\x0A\xF3\x0F\x11\xB3\x1C\x09\x00\x00\xEB\x25", "xxxxxx????xx");
+    constexpr auto dirtLevelPattern = mem::MakePattern("\x0F\x29\x7C\x24\x30\x0F\x85\xE3\x00\x00\x00\xF3\x0F\x10\xB9\x68\x09\x00\x00",
+        "xx???xx????xxxx????");
+    constexpr auto engineTempPattern = mem::MakePattern("\xF3\x0F\x11\x9B\xDC\x09\x00\x00\x0F\x84\xB1\x00\x00\x00",
+        "xxxx????xxx???");
+    constexpr auto dashSpeedPattern = mem::MakePattern("\xF3\x0F\x10\x8F\x10\x0A\x00\x00\xF3\x0F\x59\x05\x5E\x30\x8D\x00",
+        "xxxx????xxxx????");
+    constexpr auto modelTypePattern = mem::MakePattern("\x8B\x83\x38\x0B\x00\x00\x83\xE8\x08\x83\xF8\x02", "xx????xx?xxx");
+    constexpr auto wheelsPtrPattern = mem::MakePattern("\x3B\xB7\x48\x0B\x00\x00\x7D\x0D", "xx????xx");
+    constexpr auto vehicleFlagsPattern = mem::MakePattern("\x48\x85\xC0\x74\x3C\x8B\x80\x00\x00\x00\x00\xC1\xE8\x0F", "xxxxxxx????xxx");
+    constexpr auto steeringMultPattern = mem::MakePattern("\x0F\xBA\xAB\xEC\x01\x00\x00\x09\x0F\x2F\xB3\x40\x01\x00\x00\x48\x8B\x83\x20\x01\x00\x00",
+        "xx?????xxx???xxxx?????");
+    constexpr auto wheelFlagsPattern = mem::MakePattern("\x75\x11\x48\x8b\x01\x8b\x88", "xxxxxxx");
+    constexpr auto wheelHealthPattern = mem::MakePattern("\x75\x24\xF3\x0F\x10\x81\xE0\x01\x00\x00\xF3\x0F\x5C\xC1", "xxxxx???xxxx??");
+    constexpr auto wheelSuspensionCompressionPattern = mem::MakePattern("\x45\x0f\x57\xc9\xf3\x0f\x11\x83\x60\x01\x00\x00\xf3\x0f\x5c", "xxx?xxx???xxxxx");
+    constexpr auto wheelSteeringAnglePattern1737 = mem::MakePattern("\x0F\x2F\x81\xBC\x01\x00\x00" "\x0F\x97\xC0" "\xEB\x00" "\xD1\x00", "xx???xx" "xxx" "x?" "x?");
+    constexpr auto wheelSteeringAnglePattern = mem::MakePattern("\x0F\x2F\x81\xBC\x01\x00\x00" "\x0F\x97\xC0\xEB\xDA", "xx???xx" "xxxxx");
+    // Only tested for b2245
+    constexpr auto wheelMatTyreGripPattern = mem::MakePattern("89 8B ? ? 00 00 E8 ? ? ? ? 0F 57 ?");
+    constexpr auto wheelMatTypePattern = mem::MakePattern("88 8B ? ? 00 00 41 0F B6 47 51 66 89 83 ? ? 00 00");
+}
+
 void VehicleExtensions::SetVersion(int version) {
     g_gameVersion = static_cast<eGameVersion>(version);
     if (g_gameVersion >= G_VER_1_0_1604_0_STEAM) {
@@ -93,35 +145,85 @@ uint8_t VehicleExtensions::GearsAvailable() {
 /*
  * Offsets/patterns done by me might need revision, but they've been checked
  * against b1180.2 and b877.1 and are okay.
+ *
+ * All patterns are registered first and resolved in a single pass over the
+ * game module, instead of a full scan for each of them.
  */
-void VehicleExtensions::Init() {
-    mem::init();
+void VehicleExtensions::Init(const std::string& cacheFile) {
+    TRACE_SCOPE("VehicleExtensions::Init");
+    mem::PatternBatch batch;
+    mem::initPatterns(batch);
+
+    const auto rocketBoostActiveId = batch.Add(rocketBoostActivePattern);
+    const auto rocketBoostChargeId = batch.Add(rocketBoostChargePattern);
+    const auto hoverTransformRatioId = batch.Add(hoverTransformRatioPattern);
+    const auto fuelLevelId = batch.Add(fuelLevelPattern);
+    const auto nextGearId = batch.Add(nextGearPattern);
+
+    size_t driveForceId = SIZE_MAX;
+    if (g_gameVersion >= G_VER_1_0_1604_0_STEAM) {
+        driveForceId = batch.Add(driveForcePattern1604);
+    }
+
+    const auto currentRPMId = batch.Add(currentRPMPattern);
+
+    size_t turboId;
+    if (g_gameVersion >= G_VER_1_0_1604_0_STEAM) {
+        turboId = batch.Add(turboPattern1604);
+    }
+    else {
+        turboId = batch.Add(turboPattern);
+    }
+
+    const auto handlingId = batch.Add(handlingPattern);
+    const auto lightStatesId = batch.Add(lightStatesPattern);
+    const auto indicatorTimingId = batch.Add(indicatorTimingPattern);
+    const auto steeringAngleInputId = batch.Add(steeringAngleInputPattern);
+    const auto dirtLevelId = batch.Add(dirtLevelPattern);
+    const auto engineTempId = batch.Add(engineTempPattern);
+    const auto dashSpeedId = batch.Add(dashSpeedPattern);
+    const auto modelTypeId = batch.Add(modelTypePattern);
+    const auto wheelsPtrId = batch.Add(wheelsPtrPattern);
+    const auto vehicleFlagsId = batch.Add(vehicleFlagsPattern);
+    const auto steeringMultId = batch.Add(steeringMultPattern);
+    const auto wheelFlagsId = batch.Add(wheelFlagsPattern);
+    const auto wheelHealthId = batch.Add(wheelHealthPattern);
+    const auto wheelSuspensionCompressionId = batch.Add(wheelSuspensionCompressionPattern);
+
+    size_t wheelSteeringAngleId;
+    if (g_gameVersion >= G_VER_1_0_1737_0_STEAM) {
+        wheelSteeringAngleId = batch.Add(wheelSteeringAnglePattern1737);
+    }
+    else {
+        wheelSteeringAngleId = batch.Add(wheelSteeringAnglePattern);
+    }
 
-    uintptr_t addr = mem::FindPattern("3A 91 ? ? ? ? 74 ? 84 D2");
+    const auto wheelMatTyreGripId = batch.Add(wheelMatTyreGripPattern);
+    const auto wheelMatTypeId = batch.Add(wheelMatTypePattern);
+
+    mem::ScanModule(batch, cacheFile);
+    mem::initResolve(batch);
+
+    uintptr_t addr = batch.Get(rocketBoostActiveId);
     rocketBoostActiveOffset = addr == 0 ? 0 : *(int*)(addr + 2);
     logger.Write(rocketBoostActiveOffset == 0 ? WARN : DEBUG, "Rocket Boost Active Offset: 0x%X", rocketBoostActiveOffset);
 
-    addr = mem::FindPattern("\x48\x8B\x47\x00\xF3\x44\x0F\x10\x9F\x00\x00\x00\x00", "xxx?xxxxx????");
+    addr = batch.Get(rocketBoostChargeId);
     rocketBoostChargeOffset = addr == 0 ? 0 : *(int*)(addr + 9);
     logger.Write(rocketBoostChargeOffset == 0 ? WARN : DEBUG, "Rocket Boost Charge Offset: 0x%X", rocketBoostChargeOffset);
 
-    // Unknown
-    addr = mem::FindPattern("\xF3\x0F\x11\xB3\x00\x00\x00\x00\x44\x88\x00\x00\x00\x00\x00\x48\x85\xC9",
-        "xxxx????xx?????xxx");
+    addr = batch.Get(hoverTransformRatioId);
     hoverTransformRatioOffset = addr == 0 ? 0 : *(int*)(addr + 4);
     logger.Write(hoverTransformRatioOffset == 0 ? WARN : DEBUG, "Hover Transform Active Offset: 0x%X", hoverTransformRatioOffset);
 
-    //addr = mem::FindPattern("\xF3\x0F\x11\xB3\x00\x00\x00\x00\x44\x88\x00\x00\x00\x00\x00\x48\x85\xC9",
-    //    "xxxx????xx?????xxx");
     hoverTransformRatioLerpOffset = addr == 0 ? 0 : *(int*)(addr + 4) + 0x28;
     logger.Write(hoverTransformRatioLerpOffset == 0 ? WARN : DEBUG, "Hover Transform Ratio Offset: 0x%X", hoverTransformRatioLerpOffset);
 
-    addr = mem::FindPattern("\x74\x26\x0F\x57\xC9", "xxxxx");
+    addr = batch.Get(fuelLevelId);
     fuelLevelOffset = addr == 0 ? 0 : *(int*)(addr + 8);
     logger.Write(fuelLevelOffset == 0 ? WARN : DEBUG, "Fuel Level Offset: 0x%X", fuelLevelOffset);
 
-    addr = mem::FindPattern("\x48\x8D\x8F\x00\x00\x00\x00\x4C\x8B\xC3\xF3\x0F\x11\x7C\x24",
-        "xxx????xxxxxxxx");
+    addr = batch.Get(nextGearId);
     nextGearOffset = addr == 0 ? 0 : *(int*)(addr + 3);
     logger.Write(nextGearOffset == 0 ? WARN : DEBUG, "Next Gear Offset: 0x%X", nextGearOffset);
 
@@ -135,7 +237,7 @@ void VehicleExtensions::Init() {
     logger.Write(gearRatiosOffset == 0 ? WARN : DEBUG, "Gear Ratios Offset: 0x%X", gearRatiosOffset);
 
     if (g_gameVersion >= G_VER_1_0_1604_0_STEAM) {
-        addr = mem::FindPattern("\xF3\x0F\x10\x8F\xA4\x08\x00\x00\xF3\x0F\x5E\xF0\x41\x0F\x2F\xCA", "xxxx????xxx?xxx?");
+        addr = batch.Get(driveForceId);
         driveForceOffset = addr == 0 ? 0 : *(int*)(addr + 4);
     }
     else {
@@ -149,8 +251,7 @@ void VehicleExtensions::Init() {
     driveMaxFlatVelOffset = driveForceOffset == 0 ? 0 : driveForceOffset + 0x08;
     logger.Write(driveMaxFlatVelOffset == 0 ? WARN : DEBUG, "Drive Max Flat Velocity Offset: 0x%X", driveMaxFlatVelOffset);
 
-    addr = mem::FindPattern("\x76\x03\x0F\x28\xF0\xF3\x44\x0F\x10\x93",
-        "xxxxxxxxxx");
+    addr = batch.Get(currentRPMId);
     currentRPMOffset = addr == 0 ? 0 : *(int*)(addr + 10);
     logger.Write(currentRPMOffset == 0 ? WARN : DEBUG, "RPM Offset: 0x%X", currentRPMOffset);
 
@@ -160,13 +261,7 @@ void VehicleExtensions::Init() {
     throttleOffset = addr == 0 ? 0 : *(int*)(addr + 10) + 0x10;
     logger.Write(throttleOffset == 0 ? WARN : DEBUG, "Throttle Offset: 0x%X", throttleOffset);
 
-    if (g_gameVersion >= G_VER_1_0_1604_0_STEAM) {
-        addr = mem::FindPattern("\xF3\x0F\x10\x9F\xD4\x08\x00\x00\x0F\x2F\xDF\x73\x0A", "xxxx????xxxxx");
-    }
-    else {
-        addr = mem::FindPattern("\xF3\x0F\x10\x8F\x68\x08\x00\x00\x88\x4D\x8C\x0F\x2F\xCF",
-            "xxxx????xxx???");
-    }
+    addr = batch.Get(turboId);
     turboOffset = addr == 0 ? 0 : *(int*)(addr + 4);
     logger.Write(turboOffset == 0 ? WARN : DEBUG, "Turbo Offset: 0x%X", turboOffset);
 
@@ -178,23 +273,19 @@ void VehicleExtensions::Init() {
         arenaBoostOffset = 0;
     }
 
-    addr = mem::FindPattern("\x3C\x03\x0F\x85\x00\x00\x00\x00\x48\x8B\x41\x20\x48\x8B\x88",
-        "xxxx????xxxxxxx");
+    addr = batch.Get(handlingId);
     handlingOffset = addr == 0 ? 0 : *(int*)(addr + 0x16);
     logger.Write(handlingOffset == 0 ? WARN : DEBUG, "Handling Offset: 0x%X", handlingOffset);
 
-    addr = mem::FindPattern("FD 02 DB 08 98 ? ? ? ? 48 8B 5C 24 30");
+    addr = batch.Get(lightStatesId);
     lightStatesOffset = addr == 0 ? 0 : *(int*)(addr - 4) - 1;
     logger.Write(lightStatesOffset == 0 ? WARN : DEBUG, "Light States Offset: 0x%X", lightStatesOffset);
-    // Or "8A 96 ? ? ? ? 0F B6 C8 84 D2 41", +10 or something (+31 is the engine starting bit), (0x928 starting addr)
 
-    // Figuring out indicator timing: LieutenantDan
-    addr = mem::FindPattern("\x44\x0F\xB7\x91\xDC\x00\x00\x00\x0F\xB7\x81\xB0\x0A\x00\x00\x41\xB9\x01\x00\x00\x00\x44\x03\x15\x8C\x63\xDF\x01",
-        "xxxx????xxx????xxxxxxxxx????");
+    addr = batch.Get(indicatorTimingId);
     indicatorTimingOffset = addr == 0 ? 0 : *(int*)(addr + 4);
     logger.Write(indicatorTimingOffset == 0 ? WARN : DEBUG, "Indicator timing offset: 0x%X", indicatorTimingOffset);
 
-    addr = mem::FindPattern("\x74\x0A\xF3\x0F\x11\xB3\x1C\x09\x00\x00\xEB\x25", "xxxxxx????xx");
+    addr = batch.Get(steeringAngleInputId);
     steeringAngleInputOffset = addr == 0 ? 0 : *(int*)(addr + 6);
     logger.Write(steeringAngleInputOffset == 0 ? WARN : DEBUG, "Steering Input Offset: 0x%X", steeringAngleInputOffset);
 
@@ -207,55 +298,51 @@ void VehicleExtensions::Init() {
     brakePOffset = addr == 0 ? 0 : *(int*)(addr + 6) + 0x14;
     logger.Write(brakePOffset == 0 ? WARN : DEBUG, "BrakeP Offset: 0x%X", brakePOffset);
 
-    addr = mem::FindPattern("\x0F\x29\x7C\x24\x30\x0F\x85\xE3\x00\x00\x00\xF3\x0F\x10\xB9\x68\x09\x00\x00",
-        "xx???xx????xxxx????");
+    addr = batch.Get(dirtLevelId);
     dirtLevelOffset = addr == 0 ? 0 : *(int*)(addr + 0xF);
     logger.Write(dirtLevelOffset == 0 ? WARN : DEBUG, "Dirt Level Offset: 0x%X", dirtLevelOffset);
 
-    addr = mem::FindPattern("\xF3\x0F\x11\x9B\xDC\x09\x00\x00\x0F\x84\xB1\x00\x00\x00",
-        "xxxx????xxx???");
+    addr = batch.Get(engineTempId);
     engineTempOffset = addr == 0 ? 0 : *(int*)(addr + 4);
     logger.Write(engineTempOffset == 0 ? WARN : DEBUG, "Engine Temperature Offset: 0x%X", engineTempOffset);
 
-    addr = mem::FindPattern("\xF3\x0F\x10\x8F\x10\x0A\x00\x00\xF3\x0F\x59\x05\x5E\x30\x8D\x00",
-        "xxxx????xxxx????");
+    addr = batch.Get(dashSpeedId);
     dashSpeedOffset = addr == 0 ? 0 : *(int*)(addr + 4);
     logger.Write(dashSpeedOffset == 0 ? WARN : DEBUG, "Dashboard Speed Offset: 0x%X", dashSpeedOffset);
 
-    addr = mem::FindPattern("\x8B\x83\x38\x0B\x00\x00\x83\xE8\x08\x83\xF8\x02", "xx????xx?xxx");
+    addr = batch.Get(modelTypeId);
     modelTypeOffset = addr == 0 ? 0 : *(int*)(addr + 2);
     logger.Write(modelTypeOffset == 0 ? WARN : DEBUG, "Model Type Offset: 0x%X", modelTypeOffset);
 
-    addr = mem::FindPattern("\x3B\xB7\x48\x0B\x00\x00\x7D\x0D", "xx????xx");
+    addr = batch.Get(wheelsPtrId);
     wheelsPtrOffset = addr == 0 ? 0 : *(int*)(addr + 2) - 8;
     logger.Write(wheelsPtrOffset == 0 ? WARN : DEBUG, "Wheels Pointer Offset: 0x%X", wheelsPtrOffset);
 
     numWheelsOffset = addr == 0 ? 0 : *(int*)(addr + 2);
     logger.Write(numWheelsOffset == 0 ? WARN : DEBUG, "Wheel Count Offset: 0x%X", numWheelsOffset);
 
-    addr = mem::FindPattern("\x48\x85\xC0\x74\x3C\x8B\x80\x00\x00\x00\x00\xC1\xE8\x0F", "xxxxxxx????xxx");
+    addr = batch.Get(vehicleFlagsId);
     vehicleFlagsOffset = addr == 0 ? 0 : *(int*)(addr + 7);
     logger.Write(vehicleFlagsOffset == 0 ? WARN : DEBUG, "Vehicle Flags Offset: 0x%X", vehicleFlagsOffset);
 
-    addr = mem::FindPattern("\x0F\xBA\xAB\xEC\x01\x00\x00\x09\x0F\x2F\xB3\x40\x01\x00\x00\x48\x8B\x83\x20\x01\x00\x00",
-        "xx?????xxx???xxxx?????");
+    addr = batch.Get(steeringMultId);
     steeringMultOffset = addr == 0 ? 0 : *(int*)(addr + 11);
     logger.Write(steeringMultOffset == 0 ? WARN : DEBUG, "Steering Multiplier Offset: 0x%X", steeringMultOffset);
 
-    addr = mem::FindPattern("\x75\x11\x48\x8b\x01\x8b\x88", "xxxxxxx");
+    addr = batch.Get(wheelFlagsId);
     wheelFlagsOffset = addr == 0 ? 0 : *(int*)(addr + 7);
     logger.Write(wheelFlagsOffset == 0 ? WARN : DEBUG, "Wheel Flags Offset: 0x%X", wheelFlagsOffset);
 
     wheelDownforceOffset = addr == 0 ? 0 : *(int*)(addr + 7) + 0x1C;
     logger.Write(wheelDownforceOffset == 0 ? WARN : DEBUG, "Wheel Downforce Offset: 0x%X", wheelDownforceOffset);
 
-    addr = mem::FindPattern("\x75\x24\xF3\x0F\x10\x81\xE0\x01\x00\x00\xF3\x0F\x5C\xC1", "xxxxx???xxxx??");
+    addr = batch.Get(wheelHealthId);
     wheelHealthOffset = addr == 0 ? 0 : *(int*)(addr + 6);
     logger.Write(wheelHealthOffset == 0 ? WARN : DEBUG, "Wheel Health Offset: 0x%X", wheelHealthOffset);
 
     // wheelHealthOffset + float = tyre health
 
-    addr = mem::FindPattern("\x45\x0f\x57\xc9\xf3\x0f\x11\x83\x60\x01\x00\x00\xf3\x0f\x5c", "xxx?xxx???xxxxx");
+    addr = batch.Get(wheelSuspensionCompressionId);
     wheelSuspensionCompressionOffset = addr == 0 ? 0 : *(int*)(addr + 8);
     logger.Write(wheelSuspensionCompressionOffset == 0 ? WARN : DEBUG, "Wheel Suspension Compression Offset: 0x%X", wheelSuspensionCompressionOffset);
 
@@ -266,12 +353,7 @@ void VehicleExtensions::Init() {
     wheelOverheatOffset = addr == 0 ? 0 : (*(int*)(addr + 8)) + 0xc + 0x08;
     logger.Write(wheelOverheatOffset == 0 ? WARN : DEBUG, "Wheel Overheat Offset: 0x%X", wheelOverheatOffset);
 
-    if (g_gameVersion >= G_VER_1_0_1737_0_STEAM) {
-        addr = mem::FindPattern("\x0F\x2F\x81\xBC\x01\x00\x00" "\x0F\x97\xC0" "\xEB\x00" "\xD1\x00", "xx???xx" "xxx" "x?" "x?");
-    }
-    else {
-        addr = mem::FindPattern("\x0F\x2F\x81\xBC\x01\x00\x00" "\x0F\x97\xC0\xEB\xDA", "xx???xx" "xxxxx");
-    }
+    addr = batch.Get(wheelSteeringAngleId);
     wheelSteeringAngleOffset = addr == 0 ? 0 : *(int*)(addr + 3);
     logger.Write(wheelSteeringAngleOffset == 0 ? WARN : DEBUG, "Wheel Steering Angle Offset: 0x%X", wheelSteeringAngleOffset);
 
@@ -293,8 +375,7 @@ void VehicleExtensions::Init() {
     wheelTractionVectorXOffset = addr == 0 ? 0 : (*(int*)(addr + 3)) - 0x08;
     logger.Write(wheelTractionVectorXOffset == 0 ? WARN : DEBUG, "Wheel Traction Vector X Offset: 0x%X", wheelTractionVectorXOffset);
 
-    // Only tested for b2245
-    addr = mem::FindPattern("89 8B ? ? 00 00 E8 ? ? ? ? 0F 57 ?");
+    addr = batch.Get(wheelMatTyreGripId);
     wheelMatTyreGripOffset = addr == 0 ? 0 : (*(int*)(addr + 2));
     logger.Write(wheelMatTyreGripOffset == 0 ? WARN : DEBUG, "Wheel Material TYRE_GRIP Offset: 0x%X", wheelMatTyreGripOffset);
 
@@ -307,382 +388,378 @@ void VehicleExtensions::Init() {
     wheelMatTopSpeedMultOffset = addr == 0 ? 0 : (*(int*)(addr + 2) + 12);
     logger.Write(wheelMatTopSpeedMultOffset == 0 ? WARN : DEBUG, "Wheel Material TOP_SPEED_MULT Offset: 0x%X", wheelMatTopSpeedMultOffset);
 
-    addr = mem::FindPattern("88 8B ? ? 00 00 41 0F B6 47 51 66 89 83 ? ? 00 00");
+    addr = batch.Get(wheelMatTypeId);
     wheelMatTypeOffset = addr == 0 ? 0 : (*(int*)(addr + 2));
     logger.Write(wheelMatTypeOffset == 0 ? WARN : DEBUG, "Wheel Material Type Offset: 0x%X", wheelMatTypeOffset);
 }
 
-BYTE* VehicleExtensions::GetAddress(Vehicle handle) {
-    return reinterpret_cast<BYTE*>(mem::GetAddressOfEntity(handle));
-}
+VehicleView::VehicleView(Vehicle handle)
+    : mAddress(VehicleExtensions::GetAddress(handle)) {}
 
-bool VehicleExtensions::GetRocketBoostActive(Vehicle handle) {
+bool VehicleView::GetRocketBoostActive() const {
     if (rocketBoostActiveOffset == 0) return false;
-    return *reinterpret_cast<bool*>(GetAddress(handle) + rocketBoostActiveOffset);
+    return *reinterpret_cast<bool*>(mAddress + rocketBoostActiveOffset);
 }
 
-void VehicleExtensions::SetRocketBoostActive(Vehicle handle, bool val) {
+void VehicleView::SetRocketBoostActive(bool val) {
     if (rocketBoostActiveOffset == 0) return;
-    *reinterpret_cast<bool*>(GetAddress(handle) + rocketBoostActiveOffset) = val;
+    *reinterpret_cast<bool*>(mAddress + rocketBoostActiveOffset) = val;
 }
 
-float VehicleExtensions::GetRocketBoostCharge(Vehicle handle) {
+float VehicleView::GetRocketBoostCharge() const {
     if (rocketBoostChargeOffset == 0) return 0.0f;
-    return *reinterpret_cast<float*>(GetAddress(handle) + rocketBoostChargeOffset);
+    return *reinterpret_cast<float*>(mAddress + rocketBoostChargeOffset);
 }
 
-void VehicleExtensions::SetRocketBoostCharge(Vehicle handle, float value) {
+void VehicleView::SetRocketBoostCharge(float value) {
     if (rocketBoostChargeOffset == 0) return;
-    *reinterpret_cast<float*>(GetAddress(handle) + rocketBoostChargeOffset) = value;
+    *reinterpret_cast<float*>(mAddress + rocketBoostChargeOffset) = value;
 }
 
-float VehicleExtensions::GetHoverTransformRatio(Vehicle handle) {
+float VehicleView::GetHoverTransformRatio() const {
     if (hoverTransformRatioOffset == 0) return false;
-    return *reinterpret_cast<float*>(GetAddress(handle) + hoverTransformRatioOffset);
+    return *reinterpret_cast<float*>(mAddress + hoverTransformRatioOffset);
 }
 
-void VehicleExtensions::SetHoverTransformRatio(Vehicle handle, float value) {
+void VehicleView::SetHoverTransformRatio(float value) {
     if (hoverTransformRatioOffset == 0) return;
-    *reinterpret_cast<float*>(GetAddress(handle) + hoverTransformRatioOffset) = value;
+    *reinterpret_cast<float*>(mAddress + hoverTransformRatioOffset) = value;
 }
 
-float VehicleExtensions::GetHoverTransformRatioLerp(Vehicle handle) {
+float VehicleView::GetHoverTransformRatioLerp() const {
     if (hoverTransformRatioLerpOffset == 0) return 0.0f;
-    return *reinterpret_cast<float*>(GetAddress(handle) + hoverTransformRatioLerpOffset);
+    return *reinterpret_cast<float*>(mAddress + hoverTransformRatioLerpOffset);
 }
 
-void VehicleExtensions::SetHoverTransformRatioLerp(Vehicle handle, float value) {
+void VehicleView::SetHoverTransformRatioLerp(float value) {
     if (hoverTransformRatioLerpOffset == 0) return;
-    *reinterpret_cast<float*>(GetAddress(handle) + hoverTransformRatioLerpOffset) = value;
+    *reinterpret_cast<float*>(mAddress + hoverTransformRatioLerpOffset) = value;
 }
 
-float VehicleExtensions::GetFuelLevel(Vehicle handle) {
+float VehicleView::GetFuelLevel() const {
     if (fuelLevelOffset == 0) return 0.0f;
-    return *reinterpret_cast<float*>(GetAddress(handle) + fuelLevelOffset);
+    return *reinterpret_cast<float*>(mAddress + fuelLevelOffset);
 }
 
-void VehicleExtensions::SetFuelLevel(Vehicle handle, float value) {
+void VehicleView::SetFuelLevel(float value) {
     if (fuelLevelOffset == 0) return;
-    *reinterpret_cast<float*>(GetAddress(handle) + fuelLevelOffset) = value;
+    *reinterpret_cast<float*>(mAddress + fuelLevelOffset) = value;
 }
 
-uint16_t VehicleExtensions::GetGearNext(Vehicle handle) {
+uint16_t VehicleView::GetGearNext() const {
     if (nextGearOffset == 0) return 0;
-    return *reinterpret_cast<const uint16_t*>(GetAddress(handle) + nextGearOffset);
+    return *reinterpret_cast<const uint16_t*>(mAddress + nextGearOffset);
 }
 
-void VehicleExtensions::SetGearNext(Vehicle handle, uint16_t value) {
+void VehicleView::SetGearNext(uint16_t value) {
     if (nextGearOffset == 0) return;
-    *reinterpret_cast<uint16_t*>(GetAddress(handle) + nextGearOffset) = value;
+    *reinterpret_cast<uint16_t*>(mAddress + nextGearOffset) = value;
 }
 
-uint16_t VehicleExtensions::GetGearCurr(Vehicle handle) {
+uint16_t VehicleView::GetGearCurr() const {
     if (currentGearOffset == 0) return 0;
-    return *reinterpret_cast<const uint16_t*>(GetAddress(handle) + currentGearOffset);
+    return *reinterpret_cast<const uint16_t*>(mAddress + currentGearOffset);
 }
 
-void VehicleExtensions::SetGearCurr(Vehicle handle, uint16_t value) {
+void VehicleView::SetGearCurr(uint16_t value) {
     if (currentGearOffset == 0) return;
-    *reinterpret_cast<uint16_t*>(GetAddress(handle) + currentGearOffset) = value;
+    *reinterpret_cast<uint16_t*>(mAddress + currentGearOffset) = value;
 }
 
-uint8_t VehicleExtensions::GetTopGear(Vehicle handle) {
+uint8_t VehicleView::GetTopGear() const {
     if (topGearOffset == 0) return 0;
-    return *reinterpret_cast<uint8_t*>(GetAddress(handle) + topGearOffset);
+    return *reinterpret_cast<uint8_t*>(mAddress + topGearOffset);
 }
 
-void VehicleExtensions::SetTopGear(Vehicle handle, uint8_t value) {
+void VehicleView::SetTopGear(uint8_t value) {
     if (topGearOffset == 0) return;
-    *reinterpret_cast<uint8_t*>(GetAddress(handle) + topGearOffset) = value;
+    *reinterpret_cast<uint8_t*>(mAddress + topGearOffset) = value;
 }
 
-float* VehicleExtensions::GetGearRatioPtr(Vehicle handle, uint8_t gear) {
+float*VehicleView::GetGearRatioPtr(uint8_t gear) const {
     if (gearRatiosOffset == 0) return nullptr;
     return reinterpret_cast<float*>(
-        GetAddress(handle) + gearRatiosOffset + gear * sizeof(float));
+        mAddress + gearRatiosOffset + gear * sizeof(float));
 }
 
-std::vector<float> VehicleExtensions::GetGearRatios(Vehicle handle) {
+std::vector<float> VehicleView::GetGearRatios() const {
     if (gearRatiosOffset == 0) return {};
-    auto address = GetAddress(handle);
-    std::vector<float> ratios(GetTopGear(handle) + 1);
-    for (int gear = 0; gear < GetTopGear(handle) + 1; ++gear) {
-        ratios[gear] = *reinterpret_cast<float*>(address + gearRatiosOffset + gear * sizeof(float));
-    }
+    std::vector<float> ratios(GetTopGear() + 1);
+    ratios.resize(GetGearRatios(ratios.data(), static_cast<uint8_t>(ratios.size())));
     return ratios;
 }
 
-void VehicleExtensions::SetGearRatios(Vehicle handle, const std::vector<float>& values) {
+void VehicleView::SetGearRatios(const std::vector<float>& values) {
+    SetGearRatios(values.data(), static_cast<uint8_t>(values.size()));
+}
+
+uint8_t VehicleView::GetGearRatios(float* ratios, uint8_t capacity) const {
+    if (gearRatiosOffset == 0) return 0;
+    const uint8_t count = static_cast<uint8_t>(std::min<int>(GetTopGear() + 1, capacity));
+    memcpy(ratios, mAddress + gearRatiosOffset, count * sizeof(float));
+    return count;
+}
+
+void VehicleView::SetGearRatios(const float* values, uint8_t count) {
     if (gearRatiosOffset == 0) return;
-    auto address = GetAddress(handle);
-    for (uint8_t gear = 0; gear < values.size(); ++gear) {
-        *reinterpret_cast<float*>(address + gearRatiosOffset + gear * sizeof(float)) = values[gear];
+    memcpy(mAddress + gearRatiosOffset, values, count * sizeof(float));
+}
+
+bool VehicleView::GearsEqual(uint8_t topGear, float driveMaxFlatVel, const float* ratios, uint8_t count) const {
+    if (GetTopGear() != topGear || GetDriveMaxFlatVel() != driveMaxFlatVel)
+        return false;
+    if (gearRatiosOffset == 0)
+        return true;
+
+    const BYTE* gameRatios = mAddress + gearRatiosOffset;
+    uint8_t i = 0;
+#if defined(_M_X64) || defined(__SSE2__)
+    // Compare four ratios at a time, bit for bit. The rest goes to memcmp,
+    // so neither side is read past count.
+    for (; i + 4 <= count; i += 4) {
+        __m128i game = _mm_loadu_si128(reinterpret_cast<const __m128i*>(gameRatios + i * sizeof(float)));
+        __m128i ours = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ratios + i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(game, ours)) != 0xFFFF)
+            return false;
     }
+#endif
+    return memcmp(gameRatios + i * sizeof(float), ratios + i, (count - i) * sizeof(float)) == 0;
 }
 
-float VehicleExtensions::GetDriveForce(Vehicle handle) {
+float VehicleView::GetDriveForce() const {
     if (driveForceOffset == 0) return 0.0f;
-    return *reinterpret_cast<float*>(GetAddress(handle) + driveForceOffset);
+    return *reinterpret_cast<float*>(mAddress + driveForceOffset);
 }
 
-void VehicleExtensions::SetDriveForce(Vehicle handle, float value) {
+void VehicleView::SetDriveForce(float value) {
     if (driveForceOffset == 0) return;
-    *reinterpret_cast<float*>(GetAddress(handle) + driveForceOffset) = value;
+    *reinterpret_cast<float*>(mAddress + driveForceOffset) = value;
 }
 
-float VehicleExtensions::GetInitialDriveMaxFlatVel(Vehicle handle) {
+float VehicleView::GetInitialDriveMaxFlatVel() const {
     if (initialDriveMaxFlatVelOffset == 0) return 0.0f;
-    return *reinterpret_cast<float*>(GetAddress(handle) + initialDriveMaxFlatVelOffset);
+    return *reinterpret_cast<float*>(mAddress + initialDriveMaxFlatVelOffset);
 }
 
-void VehicleExtensions::SetInitialDriveMaxFlatVel(Vehicle handle, float value) {
+void VehicleView::SetInitialDriveMaxFlatVel(float value) {
     if (initialDriveMaxFlatVelOffset == 0) return;
-    *reinterpret_cast<float*>(GetAddress(handle) + initialDriveMaxFlatVelOffset) = value;
+    *reinterpret_cast<float*>(mAddress + initialDriveMaxFlatVelOffset) = value;
 }
 
-float VehicleExtensions::GetDriveMaxFlatVel(Vehicle handle) {
+float VehicleView::GetDriveMaxFlatVel() const {
     if (driveMaxFlatVelOffset == 0) return 0.0f;
-    return *reinterpret_cast<float*>(GetAddress(handle) + driveMaxFlatVelOffset);
+    return *reinterpret_cast<float*>(mAddress + driveMaxFlatVelOffset);
 }
 
-void VehicleExtensions::SetDriveMaxFlatVel(Vehicle handle, float value) {
+void VehicleView::SetDriveMaxFlatVel(float value) {
     if (driveMaxFlatVelOffset == 0) return;
-    *reinterpret_cast<float*>(GetAddress(handle) + driveMaxFlatVelOffset) = value;
+    *reinterpret_cast<float*>(mAddress + driveMaxFlatVelOffset) = value;
 }
 
-float VehicleExtensions::GetCurrentRPM(Vehicle handle) {
+float VehicleView::GetCurrentRPM() const {
     if (currentRPMOffset == 0) return 0.0f;
-    return *reinterpret_cast<const float*>(GetAddress(handle) + currentRPMOffset);
+    return *reinterpret_cast<const float*>(mAddress + currentRPMOffset);
 }
 
-void VehicleExtensions::SetCurrentRPM(Vehicle handle, float value) {
+void VehicleView::SetCurrentRPM(float value) {
     if (currentRPMOffset == 0) return;
-    *reinterpret_cast<float*>(GetAddress(handle) + currentRPMOffset) = value;
+    *reinterpret_cast<float*>(mAddress + currentRPMOffset) = value;
 }
 
-float VehicleExtensions::GetClutch(Vehicle handle) {
+float VehicleView::GetClutch() const {
     if (clutchOffset == 0) return 0.0f;
-    auto address = GetAddress(handle);
-    return address == nullptr ? 0 : *reinterpret_cast<const float*>(address + clutchOffset);
+    return mAddress == nullptr ? 0 : *reinterpret_cast<const float*>(mAddress + clutchOffset);
 }
 
-void VehicleExtensions::SetClutch(Vehicle handle, float value) {
+void VehicleView::SetClutch(float value) {
     if (clutchOffset == 0) return;
-    auto address = GetAddress(handle);
-    *reinterpret_cast<float*>(address + clutchOffset) = value;
+    *reinterpret_cast<float*>(mAddress + clutchOffset) = value;
 }
 
-float VehicleExtensions::GetThrottle(Vehicle handle) {
+float VehicleView::GetThrottle() const {
     if (throttleOffset == 0) return 0.0f;
-    auto address = GetAddress(handle);
-    return *reinterpret_cast<float*>(address + throttleOffset);
+    return *reinterpret_cast<float*>(mAddress + throttleOffset);
 }
 
 // Seems to just control the sound.
-void VehicleExtensions::SetThrottle(Vehicle handle, float value) {
+void VehicleView::SetThrottle(float value) {
     if (throttleOffset == 0) return;
-    auto address = GetAddress(handle);
-    *reinterpret_cast<float*>(address + throttleOffset) = value;
+    *reinterpret_cast<float*>(mAddress + throttleOffset) = value;
 }
 
-float VehicleExtensions::GetTurbo(Vehicle handle) {
+float VehicleView::GetTurbo() const {
     if (turboOffset == 0) return 0.0f;
-    auto address = GetAddress(handle);
-    return address == nullptr ? 0 : *reinterpret_cast<const float*>(address + turboOffset);
+    return mAddress == nullptr ? 0 : *reinterpret_cast<const float*>(mAddress + turboOffset);
 }
 
-void VehicleExtensions::SetTurbo(Vehicle handle, float value) {
+void VehicleView::SetTurbo(float value) {
     if (turboOffset == 0) return;
-    auto address = GetAddress(handle);
-    *reinterpret_cast<float*>(address + turboOffset) = value;
+    *reinterpret_cast<float*>(mAddress + turboOffset) = value;
 }
 
-float VehicleExtensions::GetArenaBoost(Vehicle handle) {
+float VehicleView::GetArenaBoost() const {
     if (arenaBoostOffset == 0) return 0.0f;
-    auto address = GetAddress(handle);
-    return address == nullptr ? 0 : *reinterpret_cast<const float*>(address + arenaBoostOffset);
+    return mAddress == nullptr ? 0 : *reinterpret_cast<const float*>(mAddress + arenaBoostOffset);
 }
 
-void VehicleExtensions::SetArenaBoost(Vehicle handle, float value) {
+void VehicleView::SetArenaBoost(float value) {
     if (arenaBoostOffset == 0) return;
-    auto address = GetAddress(handle);
-    *reinterpret_cast<float*>(address + arenaBoostOffset) = value;
+    *reinterpret_cast<float*>(mAddress + arenaBoostOffset) = value;
 }
 
-uint64_t VehicleExtensions::GetHandlingPtr(Vehicle handle) {
+uint64_t VehicleView::GetHandlingPtr() const {
     if (handlingOffset == 0) return 0;
-    auto address = GetAddress(handle);
-    return *reinterpret_cast<uint64_t*>(address + handlingOffset);
+    return *reinterpret_cast<uint64_t*>(mAddress + handlingOffset);
 }
 
-void VehicleExtensions::SetHandlingPtr(Vehicle handle, uint64_t value) {
+void VehicleView::SetHandlingPtr(uint64_t value) {
     if (handlingOffset == 0) return;
-    auto address = GetAddress(handle);
-    if (address == 0) return;
-    *reinterpret_cast<uint64_t*>(address + handlingOffset) = value;
+    if (mAddress == 0) return;
+    *reinterpret_cast<uint64_t*>(mAddress + handlingOffset) = value;
 }
 
-uint32_t VehicleExtensions::GetLightStates(Vehicle handle) {
+uint32_t VehicleView::GetLightStates() const {
     if (lightStatesOffset == 0) return 0;
-    auto address = GetAddress(handle);
-    return *reinterpret_cast<uint32_t*>(address + lightStatesOffset);
+    return *reinterpret_cast<uint32_t*>(mAddress + lightStatesOffset);
 }
 
-void VehicleExtensions::SetLightStates(Vehicle handle, uint32_t value) {
+void VehicleView::SetLightStates(uint32_t value) {
     if (lightStatesOffset == 0) return;
-    auto address = GetAddress(handle);
-    *reinterpret_cast<uint32_t*>(address + lightStatesOffset) = value;
+    *reinterpret_cast<uint32_t*>(mAddress + lightStatesOffset) = value;
 }
 
-bool VehicleExtensions::GetIndicatorHigh(Vehicle handle, int gameTime) {
+bool VehicleView::GetIndicatorHigh(int gameTime) const {
     if (indicatorTimingOffset == 0) return false;
-    auto address = GetAddress(handle);
 
-    auto a = *reinterpret_cast<uint32_t*>(address + indicatorTimingOffset);
+    auto a = *reinterpret_cast<uint32_t*>(mAddress + indicatorTimingOffset);
     a += (uint32_t)gameTime;
     a = a >> 9;
     a = a & 1;
     return a == 1;
 }
 
-float VehicleExtensions::GetSteeringInputAngle(Vehicle handle) {
+float VehicleView::GetSteeringInputAngle() const {
     if (steeringAngleInputOffset == 0) return 0;
-    auto address = GetAddress(handle);
-    return *reinterpret_cast<float*>(address + steeringAngleInputOffset);
+    return *reinterpret_cast<float*>(mAddress + steeringAngleInputOffset);
 }
 
-void VehicleExtensions::SetSteeringInputAngle(Vehicle handle, float value) {
+void VehicleView::SetSteeringInputAngle(float value) {
     if (steeringAngleInputOffset == 0) return;
-    auto address = GetAddress(handle);
-    *reinterpret_cast<float*>(address + steeringAngleInputOffset) = value;
+    *reinterpret_cast<float*>(mAddress + steeringAngleInputOffset) = value;
 }
 
-float VehicleExtensions::GetSteeringAngle(Vehicle handle) {
+float VehicleView::GetSteeringAngle() const {
     if (steeringAngleOffset == 0) return 0;
-    auto address = GetAddress(handle);
-    return *reinterpret_cast<float*>(address + steeringAngleOffset);
+    return *reinterpret_cast<float*>(mAddress + steeringAngleOffset);
 }
 
-void VehicleExtensions::SetSteeringAngle(Vehicle handle, float value) {
+void VehicleView::SetSteeringAngle(float value) {
     if (steeringAngleOffset == 0) return;
-    auto address = GetAddress(handle);
-    *reinterpret_cast<float*>(address + steeringAngleOffset) = value;
+    *reinterpret_cast<float*>(mAddress + steeringAngleOffset) = value;
 }
 
-float VehicleExtensions::GetThrottleP(Vehicle handle) {
+float VehicleView::GetThrottleP() const {
     if (throttlePOffset == 0) return 0;
-    auto address = GetAddress(handle);
-    return *reinterpret_cast<float*>(address + throttlePOffset);
+    return *reinterpret_cast<float*>(mAddress + throttlePOffset);
 }
 
-void VehicleExtensions::SetThrottleP(Vehicle handle, float value) {
+void VehicleView::SetThrottleP(float value) {
     if (throttlePOffset == 0) return;
-    auto address = GetAddress(handle);
-    *reinterpret_cast<float*>(address + throttlePOffset) = value;
+    *reinterpret_cast<float*>(mAddress + throttlePOffset) = value;
 }
 
-float VehicleExtensions::GetBrakeP(Vehicle handle) {
+float VehicleView::GetBrakeP() const {
     if (brakePOffset == 0) return 0;
-    auto address = GetAddress(handle);
-    return *reinterpret_cast<float*>(address + brakePOffset);
+    return *reinterpret_cast<float*>(mAddress + brakePOffset);
 }
 
-void VehicleExtensions::SetBrakeP(Vehicle handle, float value) {
+void VehicleView::SetBrakeP(float value) {
     if (brakePOffset == 0) return;
-    auto address = GetAddress(handle);
-    *reinterpret_cast<float*>(address + brakePOffset) = value;
+    *reinterpret_cast<float*>(mAddress + brakePOffset) = value;
 }
 
-bool VehicleExtensions::GetHandbrake(Vehicle handle) {
+bool VehicleView::GetHandbrake() const {
     if (handbrakeOffset == 0) return false;
-    auto address = GetAddress(handle);
-    return *reinterpret_cast<bool*>(address + handbrakeOffset);
+    return *reinterpret_cast<bool*>(mAddress + handbrakeOffset);
 }
 
-void VehicleExtensions::SetHandbrake(Vehicle handle, bool value) {
+void VehicleView::SetHandbrake(bool value) {
     if (handbrakeOffset == 0) return;
-    auto address = GetAddress(handle);
-    *reinterpret_cast<bool*>(address + handbrakeOffset) = value;
+    *reinterpret_cast<bool*>(mAddress + handbrakeOffset) = value;
 }
 
-float VehicleExtensions::GetDirtLevel(Vehicle handle) {
+float VehicleView::GetDirtLevel() const {
     if (dirtLevelOffset == 0) return 0;
-    auto address = GetAddress(handle);
-    return *reinterpret_cast<float*>(address + dirtLevelOffset);
+    return *reinterpret_cast<float*>(mAddress + dirtLevelOffset);
 }
 
-float VehicleExtensions::GetEngineTemp(Vehicle handle) {
+float VehicleView::GetEngineTemp() const {
     if (engineTempOffset == 0) return 0;
-    auto address = GetAddress(handle);
-    return *reinterpret_cast<float*>(address + engineTempOffset);
+    return *reinterpret_cast<float*>(mAddress + engineTempOffset);
 }
 
-float VehicleExtensions::GetDashSpeed(Vehicle handle) {
+float VehicleView::GetDashSpeed() const {
     if (dashSpeedOffset == 0) return 0;
-    auto address = GetAddress(handle);
-    return *reinterpret_cast<float*>(address + dashSpeedOffset);
+    return *reinterpret_cast<float*>(mAddress + dashSpeedOffset);
 }
 
-int VehicleExtensions::GetModelType(Vehicle handle) {
+int VehicleView::GetModelType() const {
     if (modelTypeOffset == 0) return 0;
-    auto address = GetAddress(handle);
-    return *reinterpret_cast<int*>(address + modelTypeOffset);
+    return *reinterpret_cast<int*>(mAddress + modelTypeOffset);
 }
 
-uint64_t VehicleExtensions::GetWheelsPtr(Vehicle handle) {
+uint64_t VehicleView::GetWheelsPtr() const {
     if (wheelsPtrOffset == 0) return 0;
-    auto address = GetAddress(handle);
-    return *reinterpret_cast<uint64_t*>(address + wheelsPtrOffset);
+    return *reinterpret_cast<uint64_t*>(mAddress + wheelsPtrOffset);
 }
 
-uint8_t VehicleExtensions::GetNumWheels(Vehicle handle) {
+uint8_t VehicleView::GetNumWheels() const {
     if (numWheelsOffset == 0) return 0;
-    auto address = GetAddress(handle);
-    if (address == 0) return 0;
-    return *reinterpret_cast<int*>(address + numWheelsOffset);
+    if (mAddress == 0) return 0;
+    return *reinterpret_cast<int*>(mAddress + numWheelsOffset);
 }
 
-float VehicleExtensions::GetDriveBiasFront(Vehicle handle) {
-    auto address = GetHandlingPtr(handle);
+float VehicleView::GetDriveBiasFront() const {
+    auto address = GetHandlingPtr();
     if (address == 0) return 0.0f;
     return *reinterpret_cast<float*>(address + hOffsets.fDriveBiasFront);
 }
 
-float VehicleExtensions::GetDriveBiasRear(Vehicle handle) {
-    auto address = GetHandlingPtr(handle);
+float VehicleView::GetDriveBiasRear() const {
+    auto address = GetHandlingPtr();
     if (address == 0) return 0.0f;
     return *reinterpret_cast<float*>(address + hOffsets.fDriveBiasRear);
 }
 
-float VehicleExtensions::GetPetrolTankVolume(Vehicle handle) {
-    auto address = GetHandlingPtr(handle);
+float VehicleView::GetPetrolTankVolume() const {
+    auto address = GetHandlingPtr();
     if (address == 0) return 0.0f;
     return *reinterpret_cast<float*>(address + hOffsets.fPetrolTankVolume);
 }
 
-float VehicleExtensions::GetOilVolume(Vehicle handle) {
-    auto address = GetHandlingPtr(handle);
+float VehicleView::GetOilVolume() const {
+    auto address = GetHandlingPtr();
     if (address == 0) return 0.0f;
     return *reinterpret_cast<float*>(address + hOffsets.fOilVolume);
 }
 
-float VehicleExtensions::GetMaxSteeringAngle(Vehicle handle) {
-    auto address = GetHandlingPtr(handle);
+float VehicleView::GetMaxSteeringAngle() const {
+    auto address = GetHandlingPtr();
     if (address == 0) return 0.0f;
     return *reinterpret_cast<float*>(address + hOffsets.fSteeringLock);
 }
 
-Hash VehicleExtensions::GetAIHandling(Vehicle handle) {
-    auto address = GetHandlingPtr(handle);
+Hash VehicleView::GetAIHandling() const {
+    auto address = GetHandlingPtr();
     if (address == 0) return 0;
     auto offset = 0x13C;
     if (offset == 0) return 0;
     return *reinterpret_cast<Hash*>(address + offset);
 }
 
-std::vector<uint64_t> VehicleExtensions::GetWheelPtrs(Vehicle handle) {
-    auto wheelPtr = GetWheelsPtr(handle);  // pointer to wheel pointers
-    auto numWheels = GetNumWheels(handle);
+std::vector<uint64_t> VehicleView::GetWheelPtrs() const {
+    auto wheelPtr = GetWheelsPtr();  // pointer to wheel pointers
+    auto numWheels = GetNumWheels();
     std::vector<uint64_t> wheelPtrs(numWheels);
     for (auto i = 0; i < numWheels; i++) {
         auto wheelAddr = *reinterpret_cast<uint64_t*>(wheelPtr + 0x008 * i);
@@ -691,8 +768,8 @@ std::vector<uint64_t> VehicleExtensions::GetWheelPtrs(Vehicle handle) {
     return wheelPtrs;
 }
 
-float VehicleExtensions::GetVisualHeight(Vehicle handle) {
-    auto wheelPtr = GetWheelsPtr(handle);
+float VehicleView::GetVisualHeight() const {
+    auto wheelPtr = GetWheelsPtr();
 
     auto offset = g_gameVersion >= G_VER_1_0_944_2_STEAM ? 0x080 : 0;
     if (offset == 0)
@@ -701,8 +778,8 @@ float VehicleExtensions::GetVisualHeight(Vehicle handle) {
     return *reinterpret_cast<float*>(wheelPtr + offset);
 }
 
-void VehicleExtensions::SetVisualHeight(Vehicle handle, float height) {
-    auto wheelPtr = GetWheelsPtr(handle);
+void VehicleView::SetVisualHeight(float height) {
+    auto wheelPtr = GetWheelsPtr();
     auto offset = g_gameVersion >= G_VER_1_0_944_2_STEAM ? 0x07C : 0;
 
     if (offset == 0)
@@ -711,9 +788,9 @@ void VehicleExtensions::SetVisualHeight(Vehicle handle, float height) {
     *reinterpret_cast<float*>(wheelPtr + offset) = height;
 }
 
-std::vector<float> VehicleExtensions::GetWheelHealths(Vehicle handle) {
-    auto wheelPtr = GetWheelsPtr(handle);
-    auto numWheels = GetNumWheels(handle);
+std::vector<float> VehicleView::GetWheelHealths() const {
+    auto wheelPtr = GetWheelsPtr();
+    auto numWheels = GetNumWheels();
 
     std::vector<float> healths(numWheels);
 
@@ -726,11 +803,11 @@ std::vector<float> VehicleExtensions::GetWheelHealths(Vehicle handle) {
     return healths;
 }
 
-void VehicleExtensions::SetWheelsHealth(Vehicle handle, float health) {
+void VehicleView::SetWheelsHealth(float health) {
     if (wheelHealthOffset == 0) return;
 
-    auto wheelPtr = GetWheelsPtr(handle);  // pointer to wheel pointers
-    auto numWheels = GetNumWheels(handle);
+    auto wheelPtr = GetWheelsPtr();  // pointer to wheel pointers
+    auto numWheels = GetNumWheels();
 
     for (auto i = 0; i < numWheels; i++) {
         auto wheelAddr = *reinterpret_cast<uint64_t*>(wheelPtr + 0x008 * i);
@@ -738,9 +815,9 @@ void VehicleExtensions::SetWheelsHealth(Vehicle handle, float health) {
     }
 }
 
-float VehicleExtensions::GetSteeringMultiplier(Vehicle handle) {
-    auto wheelPtr = GetWheelsPtr(handle);
-    auto numWheels = GetNumWheels(handle);
+float VehicleView::GetSteeringMultiplier() const {
+    auto wheelPtr = GetWheelsPtr();
+    auto numWheels = GetNumWheels();
 
     if (numWheels > 1) {
         auto wheelAddr = *reinterpret_cast<uint64_t*>(wheelPtr + 0x008 * 1);
@@ -749,9 +826,9 @@ float VehicleExtensions::GetSteeringMultiplier(Vehicle handle) {
     return 1.0f;
 }
 
-void VehicleExtensions::SetSteeringMultiplier(Vehicle handle, float value) {
-    auto wheelPtr = GetWheelsPtr(handle);
-    auto numWheels = GetNumWheels(handle);
+void VehicleView::SetSteeringMultiplier(float value) {
+    auto wheelPtr = GetWheelsPtr();
+    auto numWheels = GetNumWheels();
 
     for (int i = 0; i < numWheels; i++) {
         auto wheelAddr = *reinterpret_cast<uint64_t*>(wheelPtr + 0x008 * i);
@@ -760,8 +837,8 @@ void VehicleExtensions::SetSteeringMultiplier(Vehicle handle, float value) {
     }
 }
 
-std::vector<Vector3> VehicleExtensions::GetWheelOffsets(Vehicle handle) {
-    auto wheels = GetWheelPtrs(handle);
+std::vector<Vector3> VehicleView::GetWheelOffsets() const {
+    auto wheels = GetWheelPtrs();
     std::vector<Vector3> positions;
 
     int offPosX = 0x20;
@@ -779,8 +856,8 @@ std::vector<Vector3> VehicleExtensions::GetWheelOffsets(Vehicle handle) {
     return positions;
 }
 
-std::vector<Vector3> VehicleExtensions::GetWheelLastContactCoords(Vehicle handle) {
-    auto wheels = GetWheelPtrs(handle);
+std::vector<Vector3> VehicleView::GetWheelLastContactCoords() const {
+    auto wheels = GetWheelPtrs();
     std::vector<Vector3> positions;
     // 0x40: Last wheel contact coordinates
     // 0x50: Last wheel contact coordinates but centered on the wheel width
@@ -804,9 +881,9 @@ std::vector<Vector3> VehicleExtensions::GetWheelLastContactCoords(Vehicle handle
     return positions;
 }
 
-std::vector<float> VehicleExtensions::GetWheelCompressions(Vehicle handle) {
-    auto wheelPtr = GetWheelsPtr(handle);
-    auto numWheels = GetNumWheels(handle);
+std::vector<float> VehicleView::GetWheelCompressions() const {
+    auto wheelPtr = GetWheelsPtr();
+    auto numWheels = GetNumWheels();
 
     std::vector<float> compressions(numWheels);
 
@@ -819,9 +896,9 @@ std::vector<float> VehicleExtensions::GetWheelCompressions(Vehicle handle) {
     return compressions;
 }
 
-std::vector<float> VehicleExtensions::GetWheelSteeringAngles(Vehicle handle) {
-    auto wheelPtr = GetWheelsPtr(handle);
-    auto numWheels = GetNumWheels(handle);
+std::vector<float> VehicleView::GetWheelSteeringAngles() const {
+    auto wheelPtr = GetWheelsPtr();
+    auto numWheels = GetNumWheels();
 
     std::vector<float> angles(numWheels);
 
@@ -834,8 +911,8 @@ std::vector<float> VehicleExtensions::GetWheelSteeringAngles(Vehicle handle) {
     return angles;
 }
 
-std::vector<bool> VehicleExtensions::GetWheelsOnGround(Vehicle handle) {
-    auto compressions = GetWheelCompressions(handle);
+std::vector<bool> VehicleView::GetWheelsOnGround() const {
+    auto compressions = GetWheelCompressions();
     std::vector<bool> onGround;
     onGround.reserve(compressions.size());
     for (auto comp : compressions) {
@@ -844,9 +921,9 @@ std::vector<bool> VehicleExtensions::GetWheelsOnGround(Vehicle handle) {
     return onGround;
 }
 
-float VehicleExtensions::GetWheelLargestAngle(Vehicle handle) {
+float VehicleView::GetWheelLargestAngle() const {
     float largestAngle = 0.0f;
-    auto angles = GetWheelSteeringAngles(handle);
+    auto angles = GetWheelSteeringAngles();
 
     for (auto angle : angles) {
         if (abs(angle) > abs(largestAngle)) {
@@ -856,12 +933,12 @@ float VehicleExtensions::GetWheelLargestAngle(Vehicle handle) {
     return largestAngle;
 }
 
-float VehicleExtensions::GetWheelAverageAngle(Vehicle handle) {
-    auto angles = GetWheelSteeringAngles(handle);
+float VehicleView::GetWheelAverageAngle() const {
+    auto angles = GetWheelSteeringAngles();
     float wheelsSteered = 0.0f;
     float avgAngle = 0.0f;
 
-    for (int i = 0; i < GetNumWheels(handle); i++) {
+    for (int i = 0; i < GetNumWheels(); i++) {
         if (i < 3 && angles[i] != 0.0f) {
             wheelsSteered += 1.0f;
             avgAngle += angles[i];
@@ -872,13 +949,13 @@ float VehicleExtensions::GetWheelAverageAngle(Vehicle handle) {
         avgAngle /= wheelsSteered;
     }
     else {
-        avgAngle = GetSteeringAngle(handle) * GetSteeringMultiplier(handle); // tank, forklift
+        avgAngle = GetSteeringAngle() * GetSteeringMultiplier(); // tank, forklift
     }
     return avgAngle;
 }
 
-std::vector<WheelDimensions> VehicleExtensions::GetWheelDimensions(Vehicle handle) {
-    auto wheels = GetWheelPtrs(handle);
+std::vector<WheelDimensions> VehicleView::GetWheelDimensions() const {
+    auto wheels = GetWheelPtrs();
 
     std::vector<WheelDimensions> dimensionsSet;
     int offTyreRadius = 0x110;
@@ -897,9 +974,9 @@ std::vector<WheelDimensions> VehicleExtensions::GetWheelDimensions(Vehicle handl
     return dimensionsSet;
 }
 
-std::vector<float> VehicleExtensions::GetWheelRotationSpeeds(Vehicle handle) {
-    auto wheelPtr = GetWheelsPtr(handle);
-    auto numWheels = GetNumWheels(handle);
+std::vector<float> VehicleView::GetWheelRotationSpeeds() const {
+    auto wheelPtr = GetWheelsPtr();
+    auto numWheels = GetNumWheels();
     std::vector<float> speeds(numWheels);
 
     if (wheelAngularVelocityOffset == 0) return speeds;
@@ -911,42 +988,80 @@ std::vector<float> VehicleExtensions::GetWheelRotationSpeeds(Vehicle handle) {
     return speeds;
 }
 
-void VehicleExtensions::SetWheelRotationSpeed(Vehicle handle, uint8_t index, float value) {
-    if (index > GetNumWheels(handle)) return;
+void VehicleView::SetWheelRotationSpeed(uint8_t index, float value) {
+    if (index > GetNumWheels()) return;
     if (wheelAngularVelocityOffset == 0) return;
 
-    auto wheelPtr = GetWheelsPtr(handle);
+    auto wheelPtr = GetWheelsPtr();
 
     auto wheelAddr = *reinterpret_cast<uint64_t*>(wheelPtr + 0x008 * index);
     *reinterpret_cast<float*>(wheelAddr + wheelAngularVelocityOffset) = value;
 }
 
-std::vector<float> VehicleExtensions::GetTyreSpeeds(Vehicle handle) {
-    int numWheels = GetNumWheels(handle);
-    std::vector<float> rotationSpeed = GetWheelRotationSpeeds(handle);
-    std::vector<WheelDimensions> dimensionsSet = GetWheelDimensions(handle);
+std::vector<float> VehicleView::GetTyreSpeeds() const {
+    auto wheelPtr = GetWheelsPtr();
+    auto numWheels = GetNumWheels();
     std::vector<float> wheelSpeeds(numWheels);
+    if (wheelAngularVelocityOffset == 0) return wheelSpeeds;
 
-    for (int i = 0; i < numWheels; i++) {
-        wheelSpeeds[i] = rotationSpeed[i] * dimensionsSet[i].TyreRadius;
+    for (auto i = 0; i < numWheels; i++) {
+        auto wheelAddr = *reinterpret_cast<uint64_t*>(wheelPtr + 0x008 * i);
+        if (!wheelAddr) continue;
+        wheelSpeeds[i] = -*reinterpret_cast<float*>(wheelAddr + wheelAngularVelocityOffset) *
+            *reinterpret_cast<float*>(wheelAddr + 0x110);
     }
     return wheelSpeeds;
 }
 
-void VehicleExtensions::SetWheelTractionVectorLength(Vehicle handle, uint8_t index, float value) {
-    if (index > GetNumWheels(handle)) return;
+void VehicleView::GetWheelSnapshot(WheelSnapshot& snapshot) const {
+    auto wheelPtr = GetWheelsPtr();
+    snapshot.NumWheels = std::min(GetNumWheels(), WheelSnapshot::MaxWheels);
+
+    for (uint8_t i = 0; i < snapshot.NumWheels; i++) {
+        auto wheelAddr = *reinterpret_cast<uint64_t*>(wheelPtr + 0x008 * i);
+        if (!wheelAddr) {
+            snapshot.RotationSpeeds[i] = 0.0f;
+            snapshot.TyreRadii[i] = 0.0f;
+            snapshot.TyreSpeeds[i] = 0.0f;
+            snapshot.Compressions[i] = 0.0f;
+            snapshot.SteeringAngles[i] = 0.0f;
+            snapshot.Loads[i] = 0.0f;
+            snapshot.Power[i] = 0.0f;
+            snapshot.BrakePressures[i] = 0.0f;
+            snapshot.Flags[i] = 0;
+            continue;
+        }
+
+        auto readFloat = [wheelAddr](int offset) {
+            return offset == 0 ? 0.0f : *reinterpret_cast<float*>(wheelAddr + offset);
+        };
+
+        snapshot.RotationSpeeds[i] = -readFloat(wheelAngularVelocityOffset);
+        snapshot.TyreRadii[i] = readFloat(0x110);
+        snapshot.TyreSpeeds[i] = snapshot.RotationSpeeds[i] * snapshot.TyreRadii[i];
+        snapshot.Compressions[i] = readFloat(wheelSuspensionCompressionOffset);
+        snapshot.SteeringAngles[i] = readFloat(wheelSteeringAngleOffset);
+        snapshot.Loads[i] = wheelLoadOffset == 0 ? 0.0f : readFloat(0x1BC);
+        snapshot.Power[i] = readFloat(wheelPowerOffset);
+        snapshot.BrakePressures[i] = readFloat(wheelBrakeOffset);
+        snapshot.Flags[i] = wheelFlagsOffset == 0 ? 0 : *reinterpret_cast<uint16_t*>(wheelAddr + wheelFlagsOffset);
+    }
+}
+
+void VehicleView::SetWheelTractionVectorLength(uint8_t index, float value) {
+    if (index > GetNumWheels()) return;
     if (wheelTractionVectorLengthOffset == 0) return;
 
-    auto wheelPtr = GetWheelsPtr(handle);
+    auto wheelPtr = GetWheelsPtr();
 
     auto wheelAddr = *reinterpret_cast<uint64_t*>(wheelPtr + 0x008 * index);
     *reinterpret_cast<float*>(wheelAddr + wheelTractionVectorLengthOffset) = value;
 }
 
-std::vector<float> VehicleExtensions::GetWheelTractionVectorLength(Vehicle handle) {
-    auto numWheels = GetNumWheels(handle);
+std::vector<float> VehicleView::GetWheelTractionVectorLength() const {
+    auto numWheels = GetNumWheels();
     std::vector<float> values(numWheels);
-    auto wheelPtr = GetWheelsPtr(handle);
+    auto wheelPtr = GetWheelsPtr();
 
     if (wheelTractionVectorLengthOffset == 0) return values;
 
@@ -957,10 +1072,10 @@ std::vector<float> VehicleExtensions::GetWheelTractionVectorLength(Vehicle handl
     return values;
 }
 
-std::vector<float> VehicleExtensions::GetWheelTractionVectorY(Vehicle handle) {
-    auto numWheels = GetNumWheels(handle);
+std::vector<float> VehicleView::GetWheelTractionVectorY() const {
+    auto numWheels = GetNumWheels();
     std::vector<float> values(numWheels);
-    auto wheelPtr = GetWheelsPtr(handle);
+    auto wheelPtr = GetWheelsPtr();
 
     if (wheelTractionVectorYOffset == 0) return values;
 
@@ -971,10 +1086,10 @@ std::vector<float> VehicleExtensions::GetWheelTractionVectorY(Vehicle handle) {
     return values;
 }
 
-std::vector<float> VehicleExtensions::GetWheelTractionVectorX(Vehicle handle) {
-    auto numWheels = GetNumWheels(handle);
+std::vector<float> VehicleView::GetWheelTractionVectorX() const {
+    auto numWheels = GetNumWheels();
     std::vector<float> values(numWheels);
-    auto wheelPtr = GetWheelsPtr(handle);
+    auto wheelPtr = GetWheelsPtr();
 
     if (wheelTractionVectorXOffset == 0) return values;
 
@@ -985,10 +1100,10 @@ std::vector<float> VehicleExtensions::GetWheelTractionVectorX(Vehicle handle) {
     return values;
 }
 
-std::vector<float> VehicleExtensions::GetTyreGrips(Vehicle handle) {
-    auto numWheels = GetNumWheels(handle);
+std::vector<float> VehicleView::GetTyreGrips() const {
+    auto numWheels = GetNumWheels();
     std::vector<float> values(numWheels);
-    auto wheelPtr = GetWheelsPtr(handle);
+    auto wheelPtr = GetWheelsPtr();
 
     if (wheelMatTyreGripOffset == 0) return values;
 
@@ -999,10 +1114,10 @@ std::vector<float> VehicleExtensions::GetTyreGrips(Vehicle handle) {
     return values;
 }
 
-std::vector<float> VehicleExtensions::GetWetGrips(Vehicle handle) {
-    auto numWheels = GetNumWheels(handle);
+std::vector<float> VehicleView::GetWetGrips() const {
+    auto numWheels = GetNumWheels();
     std::vector<float> values(numWheels);
-    auto wheelPtr = GetWheelsPtr(handle);
+    auto wheelPtr = GetWheelsPtr();
 
     if (wheelMatWetGripOffset == 0) return values;
 
@@ -1013,10 +1128,10 @@ std::vector<float> VehicleExtensions::GetWetGrips(Vehicle handle) {
     return values;
 }
 
-std::vector<float> VehicleExtensions::GetTyreDrags(Vehicle handle) {
-    auto numWheels = GetNumWheels(handle);
+std::vector<float> VehicleView::GetTyreDrags() const {
+    auto numWheels = GetNumWheels();
     std::vector<float> values(numWheels);
-    auto wheelPtr = GetWheelsPtr(handle);
+    auto wheelPtr = GetWheelsPtr();
 
     if (wheelMatTyreDragOffset == 0) return values;
 
@@ -1027,10 +1142,10 @@ std::vector<float> VehicleExtensions::GetTyreDrags(Vehicle handle) {
     return values;
 }
 
-std::vector<float> VehicleExtensions::GetTopSpeedMults(Vehicle handle) {
-    auto numWheels = GetNumWheels(handle);
+std::vector<float> VehicleView::GetTopSpeedMults() const {
+    auto numWheels = GetNumWheels();
     std::vector<float> values(numWheels);
-    auto wheelPtr = GetWheelsPtr(handle);
+    auto wheelPtr = GetWheelsPtr();
 
     if (wheelMatTopSpeedMultOffset == 0) return values;
 
@@ -1041,10 +1156,10 @@ std::vector<float> VehicleExtensions::GetTopSpeedMults(Vehicle handle) {
     return values;
 }
 
-std::vector<uint16_t> VehicleExtensions::GetTireContactMaterial(Vehicle handle) {
-    auto numWheels = GetNumWheels(handle);
+std::vector<uint16_t> VehicleView::GetTireContactMaterial() const {
+    auto numWheels = GetNumWheels();
     std::vector<uint16_t> values(numWheels);
-    auto wheelPtr = GetWheelsPtr(handle);
+    auto wheelPtr = GetWheelsPtr();
 
     if (wheelMatTypeOffset == 0) return values;
 
@@ -1055,9 +1170,9 @@ std::vector<uint16_t> VehicleExtensions::GetTireContactMaterial(Vehicle handle)
     return values;
 }
 
-std::vector<float> VehicleExtensions::GetWheelPower(Vehicle handle) {
-    auto numWheels = GetNumWheels(handle);
-    auto wheelPtr = GetWheelsPtr(handle);
+std::vector<float> VehicleView::GetWheelPower() const {
+    auto numWheels = GetNumWheels();
+    auto wheelPtr = GetWheelsPtr();
 
     std::vector<float> values(numWheels);
 
@@ -1070,20 +1185,20 @@ std::vector<float> VehicleExtensions::GetWheelPower(Vehicle handle) {
     return values;
 }
 
-void VehicleExtensions::SetWheelPower(Vehicle handle, uint8_t index, float value) {
-    if (index > GetNumWheels(handle)) return;
+void VehicleView::SetWheelPower(uint8_t index, float value) {
+    if (index > GetNumWheels()) return;
     if (wheelPowerOffset == 0) return;
 
-    auto wheelPtr = GetWheelsPtr(handle);
+    auto wheelPtr = GetWheelsPtr();
 
     auto wheelAddr = *reinterpret_cast<uint64_t*>(wheelPtr + 0x008 * index);
     *reinterpret_cast<float*>(wheelAddr + wheelPowerOffset) = value;
 }
 
-std::vector<float> VehicleExtensions::GetWheelBrakePressure(Vehicle handle) {
-    const auto numWheels = GetNumWheels(handle);
+std::vector<float> VehicleView::GetWheelBrakePressure() const {
+    const auto numWheels = GetNumWheels();
     std::vector<float> values(numWheels);
-    auto wheelPtr = GetWheelsPtr(handle);
+    auto wheelPtr = GetWheelsPtr();
 
     if (wheelBrakeOffset == 0) return values;
 
@@ -1094,30 +1209,30 @@ std::vector<float> VehicleExtensions::GetWheelBrakePressure(Vehicle handle) {
     return values;
 }
 
-void VehicleExtensions::SetWheelBrakePressure(Vehicle handle, uint8_t index, float value) {
-    if (index > GetNumWheels(handle)) return;
+void VehicleView::SetWheelBrakePressure(uint8_t index, float value) {
+    if (index > GetNumWheels()) return;
     if (wheelBrakeOffset == 0) return;
 
-    auto wheelPtr = GetWheelsPtr(handle);
+    auto wheelPtr = GetWheelsPtr();
 
     auto wheelAddr = *reinterpret_cast<uint64_t*>(wheelPtr + 0x008 * index);
     *reinterpret_cast<float*>(wheelAddr + wheelBrakeOffset) = value;
 }
 
-bool VehicleExtensions::IsWheelPowered(Vehicle handle, uint8_t index) {
-    if (index > GetNumWheels(handle)) return false;
+bool VehicleView::IsWheelPowered(uint8_t index) const {
+    if (index > GetNumWheels()) return false;
     if (wheelFlagsOffset == 0) return false;
 
-    auto wheelPtr = GetWheelsPtr(handle);
+    auto wheelPtr = GetWheelsPtr();
     auto wheelAddr = *reinterpret_cast<uint64_t*>(wheelPtr + 0x008 * index);
     auto wheelFlags = *reinterpret_cast<uint32_t*>(wheelAddr + wheelFlagsOffset);
     return wheelFlags & 0x10;
 }
 
-std::vector<uint16_t> VehicleExtensions::GetWheelFlags(Vehicle handle) {
-    const auto numWheels = GetNumWheels(handle);
+std::vector<uint16_t> VehicleView::GetWheelFlags() const {
+    const auto numWheels = GetNumWheels();
     std::vector<uint16_t> flags(numWheels);
-    auto wheelPtr = GetWheelsPtr(handle);
+    auto wheelPtr = GetWheelsPtr();
 
     if (wheelFlagsOffset == 0) return flags;
 
@@ -1128,9 +1243,9 @@ std::vector<uint16_t> VehicleExtensions::GetWheelFlags(Vehicle handle) {
     return flags;
 }
 
-std::vector<float> VehicleExtensions::GetWheelLoads(Vehicle handle) {
-    auto wheelPtr = GetWheelsPtr(handle);
-    auto numWheels = GetNumWheels(handle);
+std::vector<float> VehicleView::GetWheelLoads() const {
+    auto wheelPtr = GetWheelsPtr();
+    auto numWheels = GetNumWheels();
     std::vector<float> values(numWheels);
 
     if (wheelLoadOffset == 0) return values;
@@ -1142,9 +1257,9 @@ std::vector<float> VehicleExtensions::GetWheelLoads(Vehicle handle) {
     return values;
 }
 
-std::vector<float> VehicleExtensions::GetWheelDownforces(Vehicle handle) {
-    auto wheelPtr = GetWheelsPtr(handle);
-    auto numWheels = GetNumWheels(handle);
+std::vector<float> VehicleView::GetWheelDownforces() const {
+    auto wheelPtr = GetWheelsPtr();
+    auto numWheels = GetNumWheels();
     std::vector<float> dfs(numWheels);
 
     if (wheelDownforceOffset == 0) return dfs;
@@ -1156,10 +1271,9 @@ std::vector<float> VehicleExtensions::GetWheelDownforces(Vehicle handle) {
     return dfs;
 }
 
-std::vector<float> VehicleExtensions::GetWheelOverheats(Vehicle handle)
-{
-    auto wheelPtr = GetWheelsPtr(handle);
-    auto numWheels = GetNumWheels(handle);
+std::vector<float> VehicleView::GetWheelOverheats() const {
+    auto wheelPtr = GetWheelsPtr();
+    auto numWheels = GetNumWheels();
     std::vector<float> vals(numWheels);
 
     if (wheelOverheatOffset == 0) return vals;
@@ -1171,40 +1285,449 @@ std::vector<float> VehicleExtensions::GetWheelOverheats(Vehicle handle)
     return vals;
 }
 
-uint64_t VehicleExtensions::GetWheelHandlingPtr(Vehicle handle, uint8_t index) {
+uint64_t VehicleView::GetWheelHandlingPtr(uint8_t index) const {
     if (handlingOffset == 0) return 0;
 
-    auto wheelPtr = GetWheelsPtr(handle);
+    auto wheelPtr = GetWheelsPtr();
     auto wheelAddr = *reinterpret_cast<uint64_t*>(wheelPtr + 0x008 * index);
 
     return *reinterpret_cast<uint64_t*>(wheelAddr + 0x120);
 }
 
-void VehicleExtensions::SetWheelHandlingPtr(Vehicle handle, uint8_t index, uint64_t value) {
+void VehicleView::SetWheelHandlingPtr(uint8_t index, uint64_t value) {
     if (handlingOffset == 0) return;
-    auto address = GetAddress(handle);
-    if (address == 0) return;
+    if (mAddress == 0) return;
 
-    auto wheelPtr = GetWheelsPtr(handle);
+    auto wheelPtr = GetWheelsPtr();
     auto wheelAddr = *reinterpret_cast<uint64_t*>(wheelPtr + 0x008 * index);
 
     *reinterpret_cast<uint64_t*>(wheelAddr + 0x120) = value;
 }
 
-std::vector<uint32_t> VehicleExtensions::GetVehicleFlags(Vehicle handle) {
-    auto address = GetAddress(handle);
+std::vector<uint32_t> VehicleView::GetVehicleFlags() const {
 
-    if (!address)
+    if (!mAddress)
         return std::vector<uint32_t>();
 
     std::vector<uint32_t> offs(6);
 
-    auto pCVehicleModelInfo = *(uint64_t*)(address + vehicleModelInfoOffset);
+    auto pCVehicleModelInfo = *(uint64_t*)(mAddress + vehicleModelInfoOffset);
     for (uint8_t i = 0; i < 6; i++) {
         offs[i] = *(uint32_t*)(pCVehicleModelInfo + vehicleFlagsOffset + sizeof(uint32_t) * i);
     }
     return offs;
 }
+BYTE* VehicleExtensions::GetAddress(Vehicle handle) {
+    return reinterpret_cast<BYTE*>(mem::GetAddressOfEntity(handle));
+}
+
+bool VehicleExtensions::GetRocketBoostActive(Vehicle handle) {
+    return VehicleView(handle).GetRocketBoostActive();
+}
+
+void VehicleExtensions::SetRocketBoostActive(Vehicle handle, bool val) {
+    VehicleView(handle).SetRocketBoostActive(val);
+}
+
+float VehicleExtensions::GetRocketBoostCharge(Vehicle handle) {
+    return VehicleView(handle).GetRocketBoostCharge();
+}
+
+void VehicleExtensions::SetRocketBoostCharge(Vehicle handle, float value) {
+    VehicleView(handle).SetRocketBoostCharge(value);
+}
+
+float VehicleExtensions::GetHoverTransformRatio(Vehicle handle) {
+    return VehicleView(handle).GetHoverTransformRatio();
+}
+
+void VehicleExtensions::SetHoverTransformRatio(Vehicle handle, float value) {
+    VehicleView(handle).SetHoverTransformRatio(value);
+}
+
+float VehicleExtensions::GetHoverTransformRatioLerp(Vehicle handle) {
+    return VehicleView(handle).GetHoverTransformRatioLerp();
+}
+
+void VehicleExtensions::SetHoverTransformRatioLerp(Vehicle handle, float value) {
+    VehicleView(handle).SetHoverTransformRatioLerp(value);
+}
+
+float VehicleExtensions::GetFuelLevel(Vehicle handle) {
+    return VehicleView(handle).GetFuelLevel();
+}
+
+void VehicleExtensions::SetFuelLevel(Vehicle handle, float value) {
+    VehicleView(handle).SetFuelLevel(value);
+}
+
+uint16_t VehicleExtensions::GetGearNext(Vehicle handle) {
+    return VehicleView(handle).GetGearNext();
+}
+
+void VehicleExtensions::SetGearNext(Vehicle handle, uint16_t value) {
+    VehicleView(handle).SetGearNext(value);
+}
+
+uint16_t VehicleExtensions::GetGearCurr(Vehicle handle) {
+    return VehicleView(handle).GetGearCurr();
+}
+
+void VehicleExtensions::SetGearCurr(Vehicle handle, uint16_t value) {
+    VehicleView(handle).SetGearCurr(value);
+}
+
+uint8_t VehicleExtensions::GetTopGear(Vehicle handle) {
+    return VehicleView(handle).GetTopGear();
+}
+
+void VehicleExtensions::SetTopGear(Vehicle handle, uint8_t value) {
+    VehicleView(handle).SetTopGear(value);
+}
+
+float*VehicleExtensions::GetGearRatioPtr(Vehicle handle, uint8_t gear) {
+    return VehicleView(handle).GetGearRatioPtr(gear);
+}
+
+std::vector<float> VehicleExtensions::GetGearRatios(Vehicle handle) {
+    return VehicleView(handle).GetGearRatios();
+}
+
+void VehicleExtensions::SetGearRatios(Vehicle handle, const std::vector<float>& values) {
+    VehicleView(handle).SetGearRatios(values);
+}
+
+float VehicleExtensions::GetDriveForce(Vehicle handle) {
+    return VehicleView(handle).GetDriveForce();
+}
+
+void VehicleExtensions::SetDriveForce(Vehicle handle, float value) {
+    VehicleView(handle).SetDriveForce(value);
+}
+
+float VehicleExtensions::GetInitialDriveMaxFlatVel(Vehicle handle) {
+    return VehicleView(handle).GetInitialDriveMaxFlatVel();
+}
+
+void VehicleExtensions::SetInitialDriveMaxFlatVel(Vehicle handle, float value) {
+    VehicleView(handle).SetInitialDriveMaxFlatVel(value);
+}
+
+float VehicleExtensions::GetDriveMaxFlatVel(Vehicle handle) {
+    return VehicleView(handle).GetDriveMaxFlatVel();
+}
+
+void VehicleExtensions::SetDriveMaxFlatVel(Vehicle handle, float value) {
+    VehicleView(handle).SetDriveMaxFlatVel(value);
+}
+
+float VehicleExtensions::GetCurrentRPM(Vehicle handle) {
+    return VehicleView(handle).GetCurrentRPM();
+}
+
+void VehicleExtensions::SetCurrentRPM(Vehicle handle, float value) {
+    VehicleView(handle).SetCurrentRPM(value);
+}
+
+float VehicleExtensions::GetClutch(Vehicle handle) {
+    return VehicleView(handle).GetClutch();
+}
+
+void VehicleExtensions::SetClutch(Vehicle handle, float value) {
+    VehicleView(handle).SetClutch(value);
+}
+
+float VehicleExtensions::GetThrottle(Vehicle handle) {
+    return VehicleView(handle).GetThrottle();
+}
+
+void VehicleExtensions::SetThrottle(Vehicle handle, float value) {
+    VehicleView(handle).SetThrottle(value);
+}
+
+float VehicleExtensions::GetTurbo(Vehicle handle) {
+    return VehicleView(handle).GetTurbo();
+}
+
+void VehicleExtensions::SetTurbo(Vehicle handle, float value) {
+    VehicleView(handle).SetTurbo(value);
+}
+
+float VehicleExtensions::GetArenaBoost(Vehicle handle) {
+    return VehicleView(handle).GetArenaBoost();
+}
+
+void VehicleExtensions::SetArenaBoost(Vehicle handle, float value) {
+    VehicleView(handle).SetArenaBoost(value);
+}
+
+uint64_t VehicleExtensions::GetHandlingPtr(Vehicle handle) {
+    return VehicleView(handle).GetHandlingPtr();
+}
+
+void VehicleExtensions::SetHandlingPtr(Vehicle handle, uint64_t value) {
+    VehicleView(handle).SetHandlingPtr(value);
+}
+
+uint32_t VehicleExtensions::GetLightStates(Vehicle handle) {
+    return VehicleView(handle).GetLightStates();
+}
+
+void VehicleExtensions::SetLightStates(Vehicle handle, uint32_t value) {
+    VehicleView(handle).SetLightStates(value);
+}
+
+bool VehicleExtensions::GetIndicatorHigh(Vehicle handle, int gameTime) {
+    return VehicleView(handle).GetIndicatorHigh(gameTime);
+}
+
+float VehicleExtensions::GetSteeringInputAngle(Vehicle handle) {
+    return VehicleView(handle).GetSteeringInputAngle();
+}
+
+void VehicleExtensions::SetSteeringInputAngle(Vehicle handle, float value) {
+    VehicleView(handle).SetSteeringInputAngle(value);
+}
+
+float VehicleExtensions::GetSteeringAngle(Vehicle handle) {
+    return VehicleView(handle).GetSteeringAngle();
+}
+
+void VehicleExtensions::SetSteeringAngle(Vehicle handle, float value) {
+    VehicleView(handle).SetSteeringAngle(value);
+}
+
+float VehicleExtensions::GetThrottleP(Vehicle handle) {
+    return VehicleView(handle).GetThrottleP();
+}
+
+void VehicleExtensions::SetThrottleP(Vehicle handle, float value) {
+    VehicleView(handle).SetThrottleP(value);
+}
+
+float VehicleExtensions::GetBrakeP(Vehicle handle) {
+    return VehicleView(handle).GetBrakeP();
+}
+
+void VehicleExtensions::SetBrakeP(Vehicle handle, float value) {
+    VehicleView(handle).SetBrakeP(value);
+}
+
+bool VehicleExtensions::GetHandbrake(Vehicle handle) {
+    return VehicleView(handle).GetHandbrake();
+}
+
+void VehicleExtensions::SetHandbrake(Vehicle handle, bool value) {
+    VehicleView(handle).SetHandbrake(value);
+}
+
+float VehicleExtensions::GetDirtLevel(Vehicle handle) {
+    return VehicleView(handle).GetDirtLevel();
+}
+
+float VehicleExtensions::GetEngineTemp(Vehicle handle) {
+    return VehicleView(handle).GetEngineTemp();
+}
+
+float VehicleExtensions::GetDashSpeed(Vehicle handle) {
+    return VehicleView(handle).GetDashSpeed();
+}
+
+int VehicleExtensions::GetModelType(Vehicle handle) {
+    return VehicleView(handle).GetModelType();
+}
+
+uint64_t VehicleExtensions::GetWheelsPtr(Vehicle handle) {
+    return VehicleView(handle).GetWheelsPtr();
+}
+
+uint8_t VehicleExtensions::GetNumWheels(Vehicle handle) {
+    return VehicleView(handle).GetNumWheels();
+}
+
+float VehicleExtensions::GetDriveBiasFront(Vehicle handle) {
+    return VehicleView(handle).GetDriveBiasFront();
+}
+
+float VehicleExtensions::GetDriveBiasRear(Vehicle handle) {
+    return VehicleView(handle).GetDriveBiasRear();
+}
+
+float VehicleExtensions::GetPetrolTankVolume(Vehicle handle) {
+    return VehicleView(handle).GetPetrolTankVolume();
+}
+
+float VehicleExtensions::GetOilVolume(Vehicle handle) {
+    return VehicleView(handle).GetOilVolume();
+}
+
+float VehicleExtensions::GetMaxSteeringAngle(Vehicle handle) {
+    return VehicleView(handle).GetMaxSteeringAngle();
+}
+
+Hash VehicleExtensions::GetAIHandling(Vehicle handle) {
+    return VehicleView(handle).GetAIHandling();
+}
+
+std::vector<uint64_t> VehicleExtensions::GetWheelPtrs(Vehicle handle) {
+    return VehicleView(handle).GetWheelPtrs();
+}
+
+float VehicleExtensions::GetVisualHeight(Vehicle handle) {
+    return VehicleView(handle).GetVisualHeight();
+}
+
+void VehicleExtensions::SetVisualHeight(Vehicle handle, float height) {
+    VehicleView(handle).SetVisualHeight(height);
+}
+
+std::vector<float> VehicleExtensions::GetWheelHealths(Vehicle handle) {
+    return VehicleView(handle).GetWheelHealths();
+}
+
+void VehicleExtensions::SetWheelsHealth(Vehicle handle, float health) {
+    VehicleView(handle).SetWheelsHealth(health);
+}
+
+float VehicleExtensions::GetSteeringMultiplier(Vehicle handle) {
+    return VehicleView(handle).GetSteeringMultiplier();
+}
+
+void VehicleExtensions::SetSteeringMultiplier(Vehicle handle, float value) {
+    VehicleView(handle).SetSteeringMultiplier(value);
+}
+
+std::vector<Vector3> VehicleExtensions::GetWheelOffsets(Vehicle handle) {
+    return VehicleView(handle).GetWheelOffsets();
+}
+
+std::vector<Vector3> VehicleExtensions::GetWheelLastContactCoords(Vehicle handle) {
+    return VehicleView(handle).GetWheelLastContactCoords();
+}
+
+std::vector<float> VehicleExtensions::GetWheelCompressions(Vehicle handle) {
+    return VehicleView(handle).GetWheelCompressions();
+}
+
+std::vector<float> VehicleExtensions::GetWheelSteeringAngles(Vehicle handle) {
+    return VehicleView(handle).GetWheelSteeringAngles();
+}
+
+std::vector<bool> VehicleExtensions::GetWheelsOnGround(Vehicle handle) {
+    return VehicleView(handle).GetWheelsOnGround();
+}
+
+float VehicleExtensions::GetWheelLargestAngle(Vehicle handle) {
+    return VehicleView(handle).GetWheelLargestAngle();
+}
+
+float VehicleExtensions::GetWheelAverageAngle(Vehicle handle) {
+    return VehicleView(handle).GetWheelAverageAngle();
+}
+
+std::vector<WheelDimensions> VehicleExtensions::GetWheelDimensions(Vehicle handle) {
+    return VehicleView(handle).GetWheelDimensions();
+}
+
+void VehicleExtensions::GetWheelSnapshot(Vehicle handle, WheelSnapshot& snapshot) {
+    VehicleView(handle).GetWheelSnapshot(snapshot);
+}
+
+std::vector<float> VehicleExtensions::GetWheelRotationSpeeds(Vehicle handle) {
+    return VehicleView(handle).GetWheelRotationSpeeds();
+}
+
+void VehicleExtensions::SetWheelRotationSpeed(Vehicle handle, uint8_t index, float value) {
+    VehicleView(handle).SetWheelRotationSpeed(index, value);
+}
+
+std::vector<float> VehicleExtensions::GetTyreSpeeds(Vehicle handle) {
+    return VehicleView(handle).GetTyreSpeeds();
+}
+
+void VehicleExtensions::SetWheelTractionVectorLength(Vehicle handle, uint8_t index, float value) {
+    VehicleView(handle).SetWheelTractionVectorLength(index, value);
+}
+
+std::vector<float> VehicleExtensions::GetWheelTractionVectorLength(Vehicle handle) {
+    return VehicleView(handle).GetWheelTractionVectorLength();
+}
+
+std::vector<float> VehicleExtensions::GetWheelTractionVectorY(Vehicle handle) {
+    return VehicleView(handle).GetWheelTractionVectorY();
+}
+
+std::vector<float> VehicleExtensions::GetWheelTractionVectorX(Vehicle handle) {
+    return VehicleView(handle).GetWheelTractionVectorX();
+}
+
+std::vector<float> VehicleExtensions::GetTyreGrips(Vehicle handle) {
+    return VehicleView(handle).GetTyreGrips();
+}
+
+std::vector<float> VehicleExtensions::GetWetGrips(Vehicle handle) {
+    return VehicleView(handle).GetWetGrips();
+}
+
+std::vector<float> VehicleExtensions::GetTyreDrags(Vehicle handle) {
+    return VehicleView(handle).GetTyreDrags();
+}
+
+std::vector<float> VehicleExtensions::GetTopSpeedMults(Vehicle handle) {
+    return VehicleView(handle).GetTopSpeedMults();
+}
+
+std::vector<uint16_t> VehicleExtensions::GetTireContactMaterial(Vehicle handle) {
+    return VehicleView(handle).GetTireContactMaterial();
+}
+
+std::vector<float> VehicleExtensions::GetWheelPower(Vehicle handle) {
+    return VehicleView(handle).GetWheelPower();
+}
+
+void VehicleExtensions::SetWheelPower(Vehicle handle, uint8_t index, float value) {
+    VehicleView(handle).SetWheelPower(index, value);
+}
+
+std::vector<float> VehicleExtensions::GetWheelBrakePressure(Vehicle handle) {
+    return VehicleView(handle).GetWheelBrakePressure();
+}
+
+void VehicleExtensions::SetWheelBrakePressure(Vehicle handle, uint8_t index, float value) {
+    VehicleView(handle).SetWheelBrakePressure(index, value);
+}
+
+bool VehicleExtensions::IsWheelPowered(Vehicle handle, uint8_t index) {
+    return VehicleView(handle).IsWheelPowered(index);
+}
+
+std::vector<uint16_t> VehicleExtensions::GetWheelFlags(Vehicle handle) {
+    return VehicleView(handle).GetWheelFlags();
+}
+
+std::vector<float> VehicleExtensions::GetWheelLoads(Vehicle handle) {
+    return VehicleView(handle).GetWheelLoads();
+}
+
+std::vector<float> VehicleExtensions::GetWheelDownforces(Vehicle handle) {
+    return VehicleView(handle).GetWheelDownforces();
+}
+
+std::vector<float> VehicleExtensions::GetWheelOverheats(Vehicle handle) {
+    return VehicleView(handle).GetWheelOverheats();
+}
+
+uint64_t VehicleExtensions::GetWheelHandlingPtr(Vehicle handle, uint8_t index) {
+    return VehicleView(handle).GetWheelHandlingPtr(index);
+}
+
+void VehicleExtensions::SetWheelHandlingPtr(Vehicle handle, uint8_t index, uint64_t value) {
+    VehicleView(handle).SetWheelHandlingPtr(index, value);
+}
+
+std::vector<uint32_t> VehicleExtensions::GetVehicleFlags(Vehicle handle) {
+    return VehicleView(handle).GetVehicleFlags();
+}
 
 
 // These apply to b1103
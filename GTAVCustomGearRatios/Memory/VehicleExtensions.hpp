@@ -1,5 +1,7 @@
 #pragma once
 #include <inc/types.h>
+#include <array>
+#include <string>
 #include <vector>
 #include <cstdint>
 
@@ -9,11 +11,263 @@ struct WheelDimensions {
     float TyreWidth;
 };
 
+// Per-wheel state of a vehicle, read in a single walk over its wheels.
+// Fixed capacity, one array per field, so filling it doesn't allocate.
+struct WheelSnapshot {
+    static constexpr uint8_t MaxWheels = 10;
+
+    uint8_t NumWheels = 0;
+    // Unit: rad/s
+    std::array<float, MaxWheels> RotationSpeeds{};
+    std::array<float, MaxWheels> TyreRadii{};
+    // Unit: m/s, at the tyres. RotationSpeeds * TyreRadii.
+    std::array<float, MaxWheels> TyreSpeeds{};
+    std::array<float, MaxWheels> Compressions{};
+    std::array<float, MaxWheels> SteeringAngles{};
+    std::array<float, MaxWheels> Loads{};
+    std::array<float, MaxWheels> Power{};
+    std::array<float, MaxWheels> BrakePressures{};
+    std::array<uint16_t, MaxWheels> Flags{};
+};
+
+// Vehicle memory accessors for a single entity.
+// The entity address is resolved once on construction, so prefer this over
+// the handle-based VehicleExtensions calls when touching a vehicle repeatedly.
+// Only valid for as long as the entity exists, so don't keep it across frames.
+class VehicleView {
+public:
+    explicit VehicleView(Vehicle handle);
+    explicit VehicleView(BYTE* address) : mAddress(address) {}
+
+    BYTE* Address() const { return mAddress; }
+
+    /*
+     * Vehicle struct
+     */
+    bool GetRocketBoostActive() const;
+    void SetRocketBoostActive(bool val);
+
+    float GetRocketBoostCharge() const;
+    void SetRocketBoostCharge(float value);
+
+    float GetHoverTransformRatio() const;
+    void SetHoverTransformRatio(float value);
+
+    float GetHoverTransformRatioLerp() const;
+    void SetHoverTransformRatioLerp(float value);
+
+    float GetFuelLevel() const;
+    void SetFuelLevel(float value);
+
+    // TODO: CVeh + 0x84c (1604 - 1868) (Lights damaged)
+
+    uint16_t GetGearNext() const;
+    void SetGearNext(uint16_t value);
+
+    uint16_t GetGearCurr() const;
+    void SetGearCurr(uint16_t value);
+
+    uint8_t GetTopGear() const;
+    void SetTopGear(uint8_t value);
+
+    // Divide GetDriveMaxFlatVel by the values in this thing to get the top
+    // speed for the gear.
+    float* GetGearRatioPtr(uint8_t gear) const;
+    std::vector<float> GetGearRatios() const;
+    void SetGearRatios(const std::vector<float>& values);
+
+    // Non-allocating variants. Reads up to capacity ratios, reverse to top
+    // gear, and returns how many were read.
+    uint8_t GetGearRatios(float* ratios, uint8_t capacity) const;
+    uint8_t GetGearRatios(std::array<float, 11>& ratios) const {
+        return GetGearRatios(ratios.data(), static_cast<uint8_t>(ratios.size()));
+    }
+    void SetGearRatios(const float* values, uint8_t count);
+
+    // True if top gear, drive max flat vel and the first count ratios are
+    // still these values. One pass, without copying the ratios out.
+    bool GearsEqual(uint8_t topGear, float driveMaxFlatVel, const float* ratios, uint8_t count) const;
+
+    float GetDriveForce() const;
+    void SetDriveForce(float value);
+
+    float GetInitialDriveMaxFlatVel() const;
+    void SetInitialDriveMaxFlatVel(float value);
+
+    float GetDriveMaxFlatVel() const;
+    void SetDriveMaxFlatVel(float value);
+
+    float GetCurrentRPM() const;
+    void SetCurrentRPM(float value);
+
+    float GetClutch() const;
+    void SetClutch(float value);
+
+    float GetThrottle() const;
+    void SetThrottle(float value);
+
+    float GetTurbo() const;
+    void SetTurbo(float value);
+
+    float GetArenaBoost() const;
+    void SetArenaBoost(float value);
+
+    uint64_t GetHandlingPtr() const;
+    void SetHandlingPtr(uint64_t value);
+
+    uint32_t GetLightStates() const;
+    void SetLightStates(uint32_t value);
+
+    bool GetIndicatorHigh(int gameTime) const;
+
+    // Steering input angle, steering lock independent
+    float GetSteeringInputAngle() const;
+    void SetSteeringInputAngle(float value);
+
+    // Wheel angle, steering lock dependent
+    float GetSteeringAngle() const;
+    void SetSteeringAngle(float value);
+
+    float GetThrottleP() const;
+    void SetThrottleP(float value);
+
+    float GetBrakeP() const;
+    void SetBrakeP(float value);
+
+    bool GetHandbrake() const;
+    void SetHandbrake(bool value);
+
+    float GetDirtLevel() const;
+    // No set impl.
+
+    float GetEngineTemp() const;
+    // No set impl.
+
+    float GetDashSpeed() const;
+    // No set impl.
+
+    //  0: car
+    //  1: plane
+    //  2: trailer
+    //  3: quad
+    //  4: ?
+    //  5: stromberg/sub
+    //  6: amphibious car
+    //  7: amphibious quad
+    //  8: heli
+    //  9: ?
+    // 10: ?
+    // 11: motorcycle
+    // 12: bicycle
+    // 13: boat
+    // 14: train
+    // 15: submarine
+    int GetModelType() const;
+
+    uint64_t GetWheelsPtr() const;
+    uint8_t GetNumWheels() const;
+
+    /*
+     * Handling data related getters
+     */
+    float GetDriveBiasFront() const;
+    float GetDriveBiasRear() const;
+    float GetPetrolTankVolume() const;
+    float GetOilVolume() const;
+    float GetMaxSteeringAngle() const;
+    Hash GetAIHandling() const;
+
+    /*
+     * Suspension info struct
+     */
+
+    std::vector<uint64_t> GetWheelPtrs() const;
+
+    // 0 is default. Pos is lowered, Neg = change height. Used by LSC. Set once.
+    // Physics are NOT affected, including hitbox.
+    float GetVisualHeight() const;
+    void SetVisualHeight(float height);
+
+    /*
+     * Wheel struct
+     */
+    std::vector<float> GetWheelHealths() const;
+    void SetWheelsHealth(float health);
+
+    float GetSteeringMultiplier() const;
+    void SetSteeringMultiplier(float value);
+
+    std::vector<Vector3> GetWheelOffsets() const;
+    std::vector<Vector3> GetWheelLastContactCoords() const;
+    std::vector<float> GetWheelCompressions() const;
+    std::vector<float> GetWheelSteeringAngles() const;
+    std::vector<bool> GetWheelsOnGround() const;
+
+    float GetWheelLargestAngle() const;
+    float GetWheelAverageAngle() const;
+
+    // Unit: meters, probably.
+    std::vector<WheelDimensions> GetWheelDimensions() const;
+
+    // Reads most per-wheel values at once. Prefer this over the separate
+    // per-wheel getters when more than one of them is needed, or per tick.
+    // Wheels past WheelSnapshot::MaxWheels are left out.
+    void GetWheelSnapshot(WheelSnapshot& snapshot) const;
+    // Unit: rad/s
+    std::vector<float> GetWheelRotationSpeeds() const;
+    // For forward, use negative speed.
+    void SetWheelRotationSpeed(uint8_t index, float value);
+    // Unit: m/s, at the tyres. This probably doesn't work well for popped tyres.
+    std::vector<float> GetTyreSpeeds() const;
+
+    std::vector<float> GetWheelTractionVectorLength() const;
+    std::vector<float> GetWheelTractionVectorY() const;
+    std::vector<float> GetWheelTractionVectorX() const;
+
+    void SetWheelTractionVectorLength(uint8_t index, float value);
+
+    // materials.meta stuff
+    std::vector<float> GetTyreGrips() const;
+    std::vector<float> GetWetGrips() const;
+    std::vector<float> GetTyreDrags() const;
+    std::vector<float> GetTopSpeedMults() const;
+    std::vector<uint16_t> GetTireContactMaterial() const;
+
+    // Needs patching the decreasing thing
+    std::vector<float> GetWheelPower() const;
+    void SetWheelPower(uint8_t index, float value);
+
+    // Strangely, braking/pulling the handbrake just adds to this value.
+    // This behavior is visible when the instruction decreasing this is patched away.
+    // Needs patching of the instruction manipulating this field for applied values
+    // to stick properly.
+    std::vector<float> GetWheelBrakePressure() const;
+    void SetWheelBrakePressure(uint8_t index, float value);
+
+    bool IsWheelPowered(uint8_t index) const;
+    std::vector<uint16_t> GetWheelFlags() const;
+
+    std::vector<float> GetWheelLoads() const;
+
+    std::vector<float> GetWheelDownforces() const;
+
+    // 0 to 59 (= pop)
+    std::vector<float> GetWheelOverheats() const;
+
+    uint64_t GetWheelHandlingPtr(uint8_t index) const;
+    void SetWheelHandlingPtr(uint8_t index, uint64_t value);
+
+    std::vector<uint32_t> GetVehicleFlags() const;
+private:
+    BYTE* mAddress;
+};
+
 class VehicleExtensions {
 public:
     static void SetVersion(int version);
 
-    static void Init();
+    // Scan results are cached in cacheFile, if given. See mem::ScanModule.
+    static void Init(const std::string& cacheFile = {});
 
     static BYTE* GetAddress(Vehicle handle);
 
@@ -21,9 +275,8 @@ public:
     // >= 1604: 11 gears
     static uint8_t GearsAvailable();
 
-    /*
-     * Vehicle struct
-     */
+    // Handle-based accessors. Each of these resolves the entity address again,
+    // see VehicleView for the accessor documentation.
     static bool GetRocketBoostActive(Vehicle handle);
     static void SetRocketBoostActive(Vehicle handle, bool val);
 
@@ -39,8 +292,6 @@ public:
     static float GetFuelLevel(Vehicle handle);
     static void SetFuelLevel(Vehicle handle, float value);
 
-    // TODO: CVeh + 0x84c (1604 - 1868) (Lights damaged)
-
     static uint16_t GetGearNext(Vehicle handle);
     static void SetGearNext(Vehicle handle, uint16_t value);
 
@@ -50,9 +301,8 @@ public:
     static uint8_t GetTopGear(Vehicle handle);
     static void SetTopGear(Vehicle handle, uint8_t value);
 
-    // Divide GetDriveMaxFlatVel by the values in this thing to get the top
-    // speed for the gear.
     static float* GetGearRatioPtr(Vehicle handle, uint8_t gear);
+
     static std::vector<float> GetGearRatios(Vehicle handle);
     static void SetGearRatios(Vehicle handle, const std::vector<float>& values);
 
@@ -88,11 +338,9 @@ public:
 
     static bool GetIndicatorHigh(Vehicle handle, int gameTime);
 
-    // Steering input angle, steering lock independent
     static float GetSteeringInputAngle(Vehicle handle);
     static void SetSteeringInputAngle(Vehicle handle, float value);
 
-    // Wheel angle, steering lock dependent
     static float GetSteeringAngle(Vehicle handle);
     static void SetSteeringAngle(Vehicle handle, float value);
 
@@ -106,115 +354,96 @@ public:
     static void SetHandbrake(Vehicle handle, bool value);
 
     static float GetDirtLevel(Vehicle handle);
-    // No set impl.
 
     static float GetEngineTemp(Vehicle handle);
-    // No set impl.
 
     static float GetDashSpeed(Vehicle handle);
-    // No set impl.
 
-    //  0: car
-    //  1: plane
-    //  2: trailer
-    //  3: quad
-    //  4: ?
-    //  5: stromberg/sub
-    //  6: amphibious car
-    //  7: amphibious quad
-    //  8: heli
-    //  9: ?
-    // 10: ?
-    // 11: motorcycle
-    // 12: bicycle
-    // 13: boat
-    // 14: train
-    // 15: submarine
     static int GetModelType(Vehicle handle);
 
     static uint64_t GetWheelsPtr(Vehicle handle);
+
     static uint8_t GetNumWheels(Vehicle handle);
 
-    /*
-     * Handling data related getters
-     */
     static float GetDriveBiasFront(Vehicle handle);
+
     static float GetDriveBiasRear(Vehicle handle);
+
     static float GetPetrolTankVolume(Vehicle handle);
+
     static float GetOilVolume(Vehicle handle);
+
     static float GetMaxSteeringAngle(Vehicle handle);
-    static Hash GetAIHandling(Vehicle handle);
 
-    /*
-     * Suspension info struct
-     */
+    static Hash GetAIHandling(Vehicle handle);
 
     static std::vector<uint64_t> GetWheelPtrs(Vehicle handle);
 
-    // 0 is default. Pos is lowered, Neg = change height. Used by LSC. Set once.
-    // Physics are NOT affected, including hitbox.
     static float GetVisualHeight(Vehicle handle);
     static void SetVisualHeight(Vehicle handle, float height);
 
-    /*
-     * Wheel struct
-     */
     static std::vector<float> GetWheelHealths(Vehicle handle);
+
     static void SetWheelsHealth(Vehicle handle, float health);
 
     static float GetSteeringMultiplier(Vehicle handle);
     static void SetSteeringMultiplier(Vehicle handle, float value);
 
     static std::vector<Vector3> GetWheelOffsets(Vehicle handle);
+
     static std::vector<Vector3> GetWheelLastContactCoords(Vehicle handle);
+
     static std::vector<float> GetWheelCompressions(Vehicle handle);
+
     static std::vector<float> GetWheelSteeringAngles(Vehicle handle);
+
     static std::vector<bool> GetWheelsOnGround(Vehicle handle);
 
     static float GetWheelLargestAngle(Vehicle handle);
+
     static float GetWheelAverageAngle(Vehicle handle);
 
-    // Unit: meters, probably.
     static std::vector<WheelDimensions> GetWheelDimensions(Vehicle handle);
-    // Unit: rad/s
+
+    static void GetWheelSnapshot(Vehicle handle, WheelSnapshot& snapshot);
+
     static std::vector<float> GetWheelRotationSpeeds(Vehicle handle);
-    // For forward, use negative speed.
     static void SetWheelRotationSpeed(Vehicle handle, uint8_t index, float value);
-    // Unit: m/s, at the tyres. This probably doesn't work well for popped tyres.
+
     static std::vector<float> GetTyreSpeeds(Vehicle handle);
 
     static std::vector<float> GetWheelTractionVectorLength(Vehicle handle);
+
     static std::vector<float> GetWheelTractionVectorY(Vehicle handle);
+
     static std::vector<float> GetWheelTractionVectorX(Vehicle handle);
 
     static void SetWheelTractionVectorLength(Vehicle handle, uint8_t index, float value);
 
-    // materials.meta stuff
     static std::vector<float> GetTyreGrips(Vehicle handle);
+
     static std::vector<float> GetWetGrips(Vehicle handle);
+
     static std::vector<float> GetTyreDrags(Vehicle handle);
+
     static std::vector<float> GetTopSpeedMults(Vehicle handle);
+
     static std::vector<uint16_t> GetTireContactMaterial(Vehicle handle);
 
-    // Needs patching the decreasing thing
     static std::vector<float> GetWheelPower(Vehicle handle);
     static void SetWheelPower(Vehicle handle, uint8_t index, float value);
 
-    // Strangely, braking/pulling the handbrake just adds to this value.
-    // This behavior is visible when the instruction decreasing this is patched away.
-    // Needs patching of the instruction manipulating this field for applied values
-    // to stick properly.
     static std::vector<float> GetWheelBrakePressure(Vehicle handle);
     static void SetWheelBrakePressure(Vehicle handle, uint8_t index, float value);
 
     static bool IsWheelPowered(Vehicle handle, uint8_t index);
+
     static std::vector<uint16_t> GetWheelFlags(Vehicle handle);
 
     static std::vector<float> GetWheelLoads(Vehicle handle);
 
     static std::vector<float> GetWheelDownforces(Vehicle handle);
 
-    // 0 to 59 (= pop)
     static std::vector<float> GetWheelOverheats(Vehicle handle);
 
     static uint64_t GetWheelHandlingPtr(Vehicle handle, uint8_t index);
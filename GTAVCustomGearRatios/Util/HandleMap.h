@@ -0,0 +1,148 @@
+#pragma once
+#include "HandleProbe.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Map from entity handles (> 0) to values.
+// Values are stored densely, in insertion order until something is erased,
+// so iterating is a walk over a plain array. Lookups go through an
+// open-addressing index (linear probing) into that array.
+template <typename T>
+class HandleMap {
+public:
+    HandleMap() {
+        mIndex.assign(initialCapacity, emptySlot);
+    }
+
+    size_t Size() const { return mValues.size(); }
+    bool Empty() const { return mValues.empty(); }
+
+    // Dense access, for 0 <= i < Size(). Erasing invalidates positions.
+    int HandleAt(size_t i) const { return mHandles[i]; }
+    T& ValueAt(size_t i) { return mValues[i]; }
+    const T& ValueAt(size_t i) const { return mValues[i]; }
+
+    T* Find(int handle) {
+        const size_t slot = findSlot(handle);
+        return slot == SIZE_MAX ? nullptr : &mValues[mIndex[slot]];
+    }
+
+    const T* Find(int handle) const {
+        const size_t slot = findSlot(handle);
+        return slot == SIZE_MAX ? nullptr : &mValues[mIndex[slot]];
+    }
+
+    bool Contains(int handle) const {
+        return findSlot(handle) != SIZE_MAX;
+    }
+
+    // Inserts value if handle isn't in the map yet. Returns the stored value,
+    // and whether it was inserted.
+    std::pair<T*, bool> Insert(int handle, const T& value) {
+        if (T* existing = Find(handle))
+            return { existing, false };
+        if (handle <= 0)
+            return { nullptr, false };
+
+        if (HandleProbe::NeedsRehash(mUsed + 1, mIndex.size()))
+            rehash(HandleProbe::RehashCapacity(mValues.size() + 1, mIndex.size()));
+
+        mHandles.push_back(handle);
+        mValues.push_back(value);
+        insertSlot(handle, static_cast<int32_t>(mValues.size() - 1));
+        return { &mValues.back(), true };
+    }
+
+    bool Erase(int handle) {
+        const size_t slot = findSlot(handle);
+        if (slot == SIZE_MAX)
+            return false;
+        eraseAt(slot);
+        return true;
+    }
+
+    // Erases entries for which pred(handle, value) is true.
+    // Returns the number erased.
+    template <typename F>
+    size_t EraseIf(F pred) {
+        size_t erased = 0;
+        for (size_t i = 0; i < mValues.size();) {
+            if (pred(mHandles[i], mValues[i])) {
+                eraseAt(findSlot(mHandles[i]));
+                ++erased;
+                // The last entry moved into i, look at it next.
+                continue;
+            }
+            ++i;
+        }
+        return erased;
+    }
+
+    void Clear() {
+        mHandles.clear();
+        mValues.clear();
+        mIndex.assign(initialCapacity, emptySlot);
+        mUsed = 0;
+    }
+
+private:
+    static constexpr size_t initialCapacity = 64;
+    static constexpr int32_t emptySlot = -1;
+    static constexpr int32_t deletedSlot = -2;
+
+    size_t findSlot(int handle) const {
+        if (handle <= 0)
+            return SIZE_MAX;
+        const size_t i = HandleProbe::Probe(handle, mIndex.size(), [&](size_t slot) {
+            const int32_t entry = mIndex[slot];
+            return entry == emptySlot || (entry >= 0 && mHandles[entry] == handle);
+        });
+        return mIndex[i] == emptySlot ? SIZE_MAX : i;
+    }
+
+    void insertSlot(int handle, int32_t denseIndex) {
+        const size_t i = HandleProbe::Probe(handle, mIndex.size(), [&](size_t slot) {
+            return mIndex[slot] < 0;
+        });
+        if (mIndex[i] == emptySlot)
+            ++mUsed;
+        mIndex[i] = denseIndex;
+    }
+
+    void eraseAt(size_t slot) {
+        const int32_t denseIndex = mIndex[slot];
+        mIndex[slot] = deletedSlot;
+
+        // Move the last entry into the hole, and point its slot there.
+        const int32_t last = static_cast<int32_t>(mValues.size() - 1);
+        if (denseIndex != last) {
+            mIndex[findSlot(mHandles[last])] = denseIndex;
+            mHandles[denseIndex] = mHandles[last];
+            mValues[denseIndex] = std::move(mValues[last]);
+        }
+        mHandles.pop_back();
+        mValues.pop_back();
+    }
+
+    void rehash(size_t capacity) {
+        mIndex.assign(capacity, emptySlot);
+        mUsed = 0;
+        for (size_t d = 0; d < mHandles.size(); ++d) {
+            const size_t i = HandleProbe::Probe(mHandles[d], capacity, [&](size_t slot) {
+                return mIndex[slot] == emptySlot;
+            });
+            mIndex[i] = static_cast<int32_t>(d);
+            ++mUsed;
+        }
+    }
+
+    std::vector<int> mHandles;
+    std::vector<T> mValues;
+    // Slot -> index into mHandles/mValues, or emptySlot/deletedSlot.
+    std::vector<int32_t> mIndex;
+    // Slots that aren't empty, deleted ones included.
+    size_t mUsed = 0;
+};
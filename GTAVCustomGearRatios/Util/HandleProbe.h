@@ -0,0 +1,41 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Open addressing with linear probing over a power-of-two number of slots,
+// for the tables keyed by entity handles (HandleSet, HandleMap).
+namespace HandleProbe {
+    // Handles keep the pool index in the upper bits, so mix everything down
+    // (murmur3 finalizer) before masking.
+    inline size_t Hash(int handle, size_t mask) {
+        uint32_t h = static_cast<uint32_t>(handle);
+        h ^= h >> 16;
+        h *= 0x85EBCA6Bu;
+        h ^= h >> 13;
+        h *= 0xC2B2AE35u;
+        h ^= h >> 16;
+        return static_cast<size_t>(h) & mask;
+    }
+
+    // Walks the slots from handle's home slot on, until done(slot) is true.
+    // Returns that slot. The table needs an empty slot for done to stop on.
+    template <typename F>
+    size_t Probe(int handle, size_t capacity, F done) {
+        const size_t mask = capacity - 1;
+        for (size_t i = Hash(handle, mask);; i = (i + 1) & mask) {
+            if (done(i))
+                return i;
+        }
+    }
+
+    // Keep probes short: at most half full, counting deleted slots.
+    inline bool NeedsRehash(size_t used, size_t capacity) {
+        return used * 2 > capacity;
+    }
+
+    // Grows when live entries take up more than a quarter, otherwise the
+    // rehash only clears out deleted slots.
+    inline size_t RehashCapacity(size_t live, size_t capacity) {
+        return live * 4 > capacity ? capacity * 2 : capacity;
+    }
+}
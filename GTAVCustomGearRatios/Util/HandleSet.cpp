@@ -0,0 +1,101 @@
+#include "HandleSet.h"
+#include "HandleProbe.h"
+
+namespace {
+    constexpr size_t initialCapacity = 2048;
+}
+
+HandleSet::HandleSet()
+    : mSlots(initialCapacity, Slot{ emptyHandle, 0 })
+    , mCount(0)
+    , mUsed(0)
+    , mEpoch(1) {}
+
+bool HandleSet::Touch(int handle) {
+    if (handle <= 0)
+        return false;
+
+    // The first deleted slot on the way is reused.
+    size_t reuse = SIZE_MAX;
+    const size_t i = HandleProbe::Probe(handle, mSlots.size(), [&](size_t slot) {
+        const int slotHandle = mSlots[slot].Handle;
+        if (slotHandle == deletedHandle && reuse == SIZE_MAX)
+            reuse = slot;
+        return slotHandle == handle || slotHandle == emptyHandle;
+    });
+
+    if (mSlots[i].Handle == handle) {
+        mSlots[i].Epoch = mEpoch;
+        return false;
+    }
+    if (reuse == SIZE_MAX) {
+        reuse = i;
+        ++mUsed;
+    }
+
+    mSlots[reuse] = Slot{ handle, mEpoch };
+    ++mCount;
+
+    if (HandleProbe::NeedsRehash(mUsed, mSlots.size())) {
+        rehash(HandleProbe::RehashCapacity(mCount, mSlots.size()));
+    }
+    return true;
+}
+
+bool HandleSet::Contains(int handle) const {
+    return handle > 0 && find(handle) != SIZE_MAX;
+}
+
+void HandleSet::Erase(int handle) {
+    if (handle <= 0)
+        return;
+    size_t i = find(handle);
+    if (i == SIZE_MAX)
+        return;
+    mSlots[i].Handle = deletedHandle;
+    --mCount;
+}
+
+size_t HandleSet::Sweep() {
+    size_t dropped = 0;
+    for (auto& slot : mSlots) {
+        if (slot.Handle > 0 && slot.Epoch != mEpoch) {
+            slot.Handle = deletedHandle;
+            ++dropped;
+        }
+    }
+    mCount -= dropped;
+    ++mEpoch;
+    return dropped;
+}
+
+void HandleSet::Clear() {
+    mSlots.assign(initialCapacity, Slot{ emptyHandle, 0 });
+    mCount = 0;
+    mUsed = 0;
+}
+
+size_t HandleSet::find(int handle) const {
+    const size_t i = HandleProbe::Probe(handle, mSlots.size(), [&](size_t slot) {
+        return mSlots[slot].Handle == handle || mSlots[slot].Handle == emptyHandle;
+    });
+    return mSlots[i].Handle == handle ? i : SIZE_MAX;
+}
+
+void HandleSet::rehash(size_t capacity) {
+    std::vector<Slot> old(capacity, Slot{ emptyHandle, 0 });
+    old.swap(mSlots);
+    mCount = 0;
+    mUsed = 0;
+
+    for (const auto& slot : old) {
+        if (slot.Handle <= 0)
+            continue;
+        const size_t i = HandleProbe::Probe(slot.Handle, mSlots.size(), [&](size_t free) {
+            return mSlots[free].Handle == emptyHandle;
+        });
+        mSlots[i] = slot;
+        ++mCount;
+        ++mUsed;
+    }
+}
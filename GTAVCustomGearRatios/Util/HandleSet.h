@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Set of entity handles (> 0), with open addressing and linear probing.
+// Handles not touched between two Sweep calls are dropped by the second one,
+// so repeatedly touching everything that still exists keeps it in sync.
+class HandleSet {
+public:
+    HandleSet();
+
+    // Adds the handle if needed, and marks it as seen for the next Sweep.
+    // Returns true if it wasn't in the set yet.
+    bool Touch(int handle);
+    bool Contains(int handle) const;
+    void Erase(int handle);
+
+    // Drops handles not touched since the previous Sweep.
+    // Returns the number of handles dropped.
+    size_t Sweep();
+    void Clear();
+
+    size_t Size() const { return mCount; }
+
+private:
+    static constexpr int emptyHandle = 0;
+    static constexpr int deletedHandle = -1;
+
+    struct Slot {
+        int Handle;
+        uint32_t Epoch;
+    };
+
+    size_t find(int handle) const;
+    void rehash(size_t capacity);
+
+    std::vector<Slot> mSlots;
+    size_t mCount;
+    // Includes deleted slots, which still lengthen probes.
+    size_t mUsed;
+    uint32_t mEpoch;
+};
@@ -0,0 +1,28 @@
+#include "Histogram.h"
+
+#include <fmt/format.h>
+#include <algorithm>
+
+void DurationHistogram::Add(int64_t us) {
+    size_t bucket = 0;
+    while (bucket < Bounds.size() && us >= Bounds[bucket])
+        ++bucket;
+    ++mBuckets[bucket];
+    ++mCount;
+    mMax = std::max(mMax, us);
+}
+
+void DurationHistogram::Reset() {
+    mBuckets.fill(0);
+    mCount = 0;
+    mMax = 0;
+}
+
+std::string DurationHistogram::Format() const {
+    std::string result;
+    for (size_t i = 0; i < Bounds.size(); ++i) {
+        result += fmt::format("<{}us: {}, ", Bounds[i], mBuckets[i]);
+    }
+    result += fmt::format(">={}us: {} (max {}us)", Bounds.back(), mBuckets.back(), mMax);
+    return result;
+}
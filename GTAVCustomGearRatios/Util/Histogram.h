@@ -0,0 +1,27 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+
+// Counts durations (microseconds) in fixed, roughly logarithmic buckets.
+class DurationHistogram {
+public:
+    // Upper bounds (exclusive) of all but the last bucket.
+    static constexpr std::array<int64_t, 8> Bounds{ 50, 100, 250, 500, 1000, 2500, 5000, 10000 };
+
+    void Add(int64_t us);
+    void Reset();
+
+    uint64_t Count() const { return mCount; }
+    int64_t Max() const { return mMax; }
+    // Bucket i counts durations below Bounds[i], the last one the rest.
+    const std::array<uint64_t, Bounds.size() + 1>& Buckets() const { return mBuckets; }
+
+    // "<50us: 12, <100us: 3, ..., >=10000us: 0 (max 420us)"
+    std::string Format() const;
+
+private:
+    std::array<uint64_t, Bounds.size() + 1> mBuckets{};
+    uint64_t mCount = 0;
+    int64_t mMax = 0;
+};
@@ -1,13 +1,86 @@
 #include "Logger.hpp"
 
-#include <iomanip>
+#ifdef _WIN32
 #include <Windows.h>
-#include <fstream>
+#else
+#include <ctime>
+#endif
+#include <algorithm>
+#include <chrono>
+#include <cstdarg>
+#include <cstring>
+
+namespace {
+    // Writer thread wakes up this often, or earlier when the queue fills up.
+    constexpr auto flushInterval = std::chrono::milliseconds(100);
+    constexpr size_t fileBufferSize = 64 * 1024;
+
+    struct ClockTime {
+        int Hour;
+        int Minute;
+        int Second;
+        int Millisecond;
+    };
 
-Logger::Logger() = default;
+    ClockTime localTime() {
+#ifdef _WIN32
+        SYSTEMTIME time;
+        GetLocalTime(&time);
+        return { time.wHour, time.wMinute, time.wSecond, time.wMilliseconds };
+#else
+        const auto now = std::chrono::system_clock::now();
+        const time_t seconds = std::chrono::system_clock::to_time_t(now);
+        tm time{};
+        localtime_r(&seconds, &time);
+        const auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() % 1000;
+        return { time.tm_hour, time.tm_min, time.tm_sec, static_cast<int>(millis) };
+#endif
+    }
+}
+
+Logger::Logger()
+    : lines(std::make_unique<Line[]>(lineCount)) {
+    static_assert((lineCount & (lineCount - 1)) == 0, "lineCount must be a power of two");
+    for (size_t i = 0; i < lineCount; ++i) {
+        lines[i].Sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+Logger::~Logger() {
+    if (thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        thread.join();
+    }
+    std::unique_lock<std::timed_mutex> lock(fileMutex, flushInterval);
+    if (lock.owns_lock()) {
+        drain();
+        closeFile();
+    }
+}
 
 void Logger::SetFile(const std::string &fileName) {
-    file = fileName;
+    // DllMain sets it on every call, usually to the same file.
+    if (fileName == file && thread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::timed_mutex> lock(fileMutex);
+        if (fileName != file) {
+            drain();
+            closeFile();
+            file = fileName;
+        }
+    }
+
+    if (!thread.joinable()) {
+        stopping = false;
+        threadDone = false;
+        thread = std::thread(&Logger::run, this);
+    }
 }
 
 void Logger::SetMinLevel(LogLevel level) {
@@ -15,37 +88,176 @@ void Logger::SetMinLevel(LogLevel level) {
 }
 
 void Logger::Clear() const {
-    std::ofstream logFile(file, std::ofstream::out | std::ofstream::trunc);
+    std::lock_guard<std::timed_mutex> lock(fileMutex);
+    // Lines queued before the clear would be gone anyway.
+    drain();
+    openFile("wb");
 }
 
 void Logger::Write(LogLevel level, const std::string& text) const {
-#ifndef _DEBUG
-    if (level < minLevel) return;
-#endif
-    std::ofstream logFile(file, std::ios_base::out | std::ios_base::app);
-    SYSTEMTIME currTimeLog;
-    GetLocalTime(&currTimeLog);
-    logFile << "[" <<
-        std::setw(2) << std::setfill('0') << currTimeLog.wHour << ":" <<
-        std::setw(2) << std::setfill('0') << currTimeLog.wMinute << ":" <<
-        std::setw(2) << std::setfill('0') << currTimeLog.wSecond << "." <<
-        std::setw(3) << std::setfill('0') << currTimeLog.wMilliseconds << "] " <<
-        "[" << levelText(level) << "] " <<
-        text << "\n";
+    if (!Enabled(level))
+        return;
+    push(level, text.c_str(), text.size());
 }
 
 void Logger::Write(LogLevel level, const char *fmt, ...) const {
+    if (!Enabled(level))
+        return;
     const int size = 1024;
     char buff[size];
     va_list args;
     va_start(args, fmt);
-    vsnprintf(buff, size, fmt, args);
+    int length = vsnprintf(buff, size, fmt, args);
     va_end(args);
-    Write(level, std::string(buff));
+    if (length < 0)
+        return;
+    push(level, buff, std::min(static_cast<size_t>(length), static_cast<size_t>(size - 1)));
+}
+
+void Logger::Flush() const {
+    std::lock_guard<std::timed_mutex> lock(fileMutex);
+    drain();
+}
+
+void Logger::Close() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wake.notify_one();
+
+    if (thread.joinable())
+        thread.join();
+
+    std::lock_guard<std::timed_mutex> lock(fileMutex);
+    drain();
+    closeFile();
+}
+
+void Logger::CloseAtDetach() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wake.notify_one();
+
+    if (thread.joinable()) {
+        // At process exit the thread is already gone, otherwise it only needs
+        // to see stopping and return.
+        auto deadline = std::chrono::steady_clock::now() + flushInterval;
+        while (!threadDone && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        thread.detach();
+    }
+
+    // A thread killed at process exit could still own it.
+    std::unique_lock<std::timed_mutex> lock(fileMutex, flushInterval);
+    if (lock.owns_lock()) {
+        drain();
+        closeFile();
+    }
+}
+
+uint64_t Logger::Dropped() const {
+    return dropped.load(std::memory_order_relaxed);
+}
+
+void Logger::push(LogLevel level, const char* text, size_t length) const {
+    const size_t mask = lineCount - 1;
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    Line* line;
+    while (true) {
+        line = &lines[pos & mask];
+        size_t sequence = line->Sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    const ClockTime currTimeLog = localTime();
+    int prefix = snprintf(line->Text, sizeof(line->Text), "[%02d:%02d:%02d.%03d] [%s] ",
+        currTimeLog.Hour, currTimeLog.Minute, currTimeLog.Second, currTimeLog.Millisecond,
+        levelStrings[level].c_str());
+    // Long lines are cut off, leaving room for the newline.
+    size_t textLength = std::min(length, sizeof(line->Text) - 1 - prefix);
+    memcpy(line->Text + prefix, text, textLength);
+    line->Text[prefix + textLength] = '\n';
+    line->Length = static_cast<uint16_t>(prefix + textLength + 1);
+    line->Sequence.store(pos + 1, std::memory_order_release);
+
+    if (pos + 1 - dequeuePos.load(std::memory_order_relaxed) >= lineCount / 4) {
+        wake.notify_one();
+    }
+}
+
+void Logger::drain() const {
+    const size_t mask = lineCount - 1;
+    size_t pos = dequeuePos.load(std::memory_order_relaxed);
+    bool wrote = false;
+    while (true) {
+        Line& line = lines[pos & mask];
+        if (line.Sequence.load(std::memory_order_acquire) != pos + 1)
+            break;
+        if (!handle && !file.empty())
+            openFile("ab");
+        if (handle)
+            fwrite(line.Text, 1, line.Length, handle);
+        line.Sequence.store(pos + lineCount, std::memory_order_release);
+        ++pos;
+        wrote = true;
+    }
+    dequeuePos.store(pos, std::memory_order_relaxed);
+
+    uint64_t droppedNow = dropped.load(std::memory_order_relaxed);
+    if (droppedNow != droppedReported && handle) {
+        fprintf(handle, "[Logger] Queue full, dropped %llu lines\n",
+            static_cast<unsigned long long>(droppedNow - droppedReported));
+        droppedReported = droppedNow;
+        wrote = true;
+    }
+
+    if (wrote && handle)
+        fflush(handle);
+}
+
+void Logger::openFile(const char* mode) const {
+    closeFile();
+    if (file.empty())
+        return;
+    handle = fopen(file.c_str(), mode);
+    if (handle)
+        setvbuf(handle, nullptr, _IOFBF, fileBufferSize);
+}
+
+void Logger::closeFile() const {
+    if (handle) {
+        fclose(handle);
+        handle = nullptr;
+    }
 }
 
-std::string Logger::levelText(LogLevel level) const {
-    return levelStrings[level];
+void Logger::run() const {
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    while (!stopping) {
+        wake.wait_for(lock, flushInterval);
+        lock.unlock();
+        {
+            std::lock_guard<std::timed_mutex> fileLock(fileMutex);
+            drain();
+        }
+        lock.lock();
+    }
+    threadDone = true;
 }
 
 // Everything's gonna use this instance.
@@ -1,7 +1,17 @@
 #pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include <fmt/format.h>
+
 enum LogLevel {
     DEBUG,
     INFO,
@@ -10,19 +20,61 @@ enum LogLevel {
     FATAL,
 };
 
+// Write formats the line on the calling thread and queues it, a background
+// thread writes queued lines to the file, which stays open. The queue is a
+// fixed size: when it's full, lines are dropped and counted instead of
+// blocking the caller.
 class Logger {
 
 public:
     Logger();
+    ~Logger();
     void SetFile(const std::string &fileName);
     void SetMinLevel(LogLevel level);
     void Clear() const;
     void Write(LogLevel level, const std::string& text) const;
     void Write(LogLevel level, const char *fmt, ...) const;
 
+    // fmt-style Write, use it through the LOG_ macros below, which check the
+    // format string at compile time.
+    template <typename S, typename... Args>
+    void Log(LogLevel level, const S& format, const Args&... args) const {
+        if (!Enabled(level))
+            return;
+        char buff[1024];
+        auto result = fmt::format_to_n(buff, sizeof(buff), format, args...);
+        push(level, buff, std::min(static_cast<size_t>(result.size), sizeof(buff)));
+    }
+
+    bool Enabled(LogLevel level) const {
+#ifdef _DEBUG
+        return true;
+#else
+        return level >= minLevel;
+#endif
+    }
+
+    // Writes everything queued so far, on the calling thread.
+    void Flush() const;
+    // Stops and joins the writer thread, then flushes and closes the file.
+    void Close();
+    // Close for DLL_PROCESS_DETACH only: the writer thread can't exit while
+    // the loader lock is held, or was killed already, so it's let go instead
+    // of joined.
+    void CloseAtDetach();
+    // Lines lost to a full queue.
+    uint64_t Dropped() const;
+
 private:
+    // Queue slot, one formatted line.
+    struct Line {
+        std::atomic<size_t> Sequence;
+        uint16_t Length;
+        char Text[1024 - sizeof(std::atomic<size_t>) - sizeof(uint16_t)];
+    };
+    static constexpr size_t lineCount = 512;
+
     std::string file = "";
-    std::string levelText(LogLevel level) const;
     LogLevel minLevel = INFO;
     const std::vector<std::string> levelStrings{
         " DEBUG ",
@@ -31,6 +83,51 @@ private:
         " ERROR ",
         " FATAL ",
     };
+
+    void push(LogLevel level, const char* text, size_t length) const;
+    // Writer side, with fileMutex held.
+    void drain() const;
+    void openFile(const char* mode) const;
+    void closeFile() const;
+    void run() const;
+
+    // Bounded MPMC queue, producers never lock.
+    std::unique_ptr<Line[]> lines;
+    mutable std::atomic<size_t> enqueuePos{ 0 };
+    mutable std::atomic<size_t> dequeuePos{ 0 };
+    mutable std::atomic<uint64_t> dropped{ 0 };
+    mutable uint64_t droppedReported = 0;
+
+    // Held by whoever drains the queue: the writer thread, Flush or Clear.
+    mutable std::timed_mutex fileMutex;
+    mutable FILE* handle = nullptr;
+
+    mutable std::thread thread;
+    mutable std::mutex wakeMutex;
+    mutable std::condition_variable wake;
+    mutable bool stopping = false;
+    mutable std::atomic<bool> threadDone{ false };
 };
 
 extern Logger logger;
+
+// LOG_ calls below this level aren't compiled in at all. DEBUG stays in by
+// default, as the Debug option turns it on at runtime.
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL DEBUG
+#endif
+
+// Arguments are only evaluated and formatted when the level is enabled.
+#define LOG(level, format, ...) \
+    do { \
+        if constexpr ((level) >= (LOG_MIN_LEVEL)) { \
+            if (logger.Enabled(level)) \
+                logger.Log((level), FMT_STRING(format), ##__VA_ARGS__); \
+        } \
+    } while (0)
+
+#define LOG_DEBUG(format, ...) LOG(DEBUG, format, ##__VA_ARGS__)
+#define LOG_INFO(format, ...)  LOG(INFO, format, ##__VA_ARGS__)
+#define LOG_WARN(format, ...)  LOG(WARN, format, ##__VA_ARGS__)
+#define LOG_ERROR(format, ...) LOG(ERROR, format, ##__VA_ARGS__)
+#define LOG_FATAL(format, ...) LOG(FATAL, format, ##__VA_ARGS__)
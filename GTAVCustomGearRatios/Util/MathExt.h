@@ -37,6 +37,14 @@ T avg(std::vector<T, A> const& vec) {
     return average / static_cast<T>(vec.size());
 }
 
+template<typename T>
+T avg(const T* values, size_t count) {
+    T average{};
+    for (size_t i = 0; i < count; ++i)
+        average += values[i];
+    return average / static_cast<T>(count);
+}
+
 template <typename T, typename = typename std::enable_if<std::is_floating_point<T>::value, T>::type>
 constexpr T rad2deg(T rad) {
     return static_cast<T>(static_cast<double>(rad) * (180.0 / M_PI));
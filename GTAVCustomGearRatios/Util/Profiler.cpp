@@ -0,0 +1,119 @@
+#include "Profiler.h"
+
+#include "Logger.hpp"
+
+#include <fmt/format.h>
+#include <algorithm>
+#include <fstream>
+
+namespace {
+    double toMicros(uint64_t nanoseconds) {
+        return static_cast<double>(nanoseconds) / 1000.0;
+    }
+}
+
+TickProfiler::TickProfiler(std::vector<std::string> stageNames)
+    : mNames(std::move(stageNames))
+    , mRows(Capacity) {
+    if (mNames.size() > MaxStages)
+        mNames.resize(MaxStages);
+}
+
+void TickProfiler::BeginTick() {
+    mRows[mTicks % Capacity].fill(notRun);
+    ++mTicks;
+}
+
+void TickProfiler::Record(size_t stage, int64_t nanoseconds) {
+    if (mTicks == 0 || stage >= mNames.size())
+        return;
+    uint32_t& cell = mRows[(mTicks - 1) % Capacity][stage];
+    uint64_t duration = static_cast<uint64_t>(std::max<int64_t>(nanoseconds, 0));
+    // A stage could run twice in a tick, count both.
+    if (cell != notRun)
+        duration += cell;
+    cell = static_cast<uint32_t>(std::min<uint64_t>(duration, notRun - 1));
+}
+
+void TickProfiler::Reset() {
+    mTicks = 0;
+}
+
+TickProfiler::Summary TickProfiler::Summarize(size_t stage) const {
+    const size_t kept = static_cast<size_t>(std::min<uint64_t>(mTicks, Capacity));
+    std::array<uint64_t, Capacity> samples;
+    size_t count = 0;
+    for (size_t i = 0; i < kept; ++i) {
+        const Row& row = rowAt(i);
+        if (stage < mNames.size()) {
+            if (row[stage] != notRun)
+                samples[count++] = row[stage];
+        }
+        else {
+            samples[count++] = total(row);
+        }
+    }
+
+    Summary summary;
+    summary.Samples = count;
+    if (count == 0)
+        return summary;
+
+    auto percentile = [&](size_t pct) {
+        size_t index = std::min(count - 1, count * pct / 100);
+        std::nth_element(samples.begin(), samples.begin() + index, samples.begin() + count);
+        return toMicros(samples[index]);
+    };
+    summary.P50 = percentile(50);
+    summary.P99 = percentile(99);
+    summary.Max = toMicros(*std::max_element(samples.begin(), samples.begin() + count));
+    return summary;
+}
+
+bool TickProfiler::WriteCsv(const std::string& file) const {
+    std::ofstream out(file, std::ios::trunc);
+    if (!out) {
+        logger.Write(ERROR, "[Profiler] Failed to open [%s]", file.c_str());
+        return false;
+    }
+
+    out << "tick";
+    for (const auto& name : mNames) {
+        out << ',' << name;
+    }
+    out << ",total\n";
+
+    const size_t kept = static_cast<size_t>(std::min<uint64_t>(mTicks, Capacity));
+    const uint64_t firstTick = mTicks - kept;
+    for (size_t i = 0; i < kept; ++i) {
+        const Row& row = rowAt(i);
+        out << firstTick + i;
+        for (size_t stage = 0; stage < mNames.size(); ++stage) {
+            out << ',';
+            if (row[stage] != notRun)
+                out << fmt::format("{:.3f}", toMicros(row[stage]));
+        }
+        out << fmt::format(",{:.3f}\n", toMicros(total(row)));
+    }
+
+    if (!out) {
+        logger.Write(ERROR, "[Profiler] Failed to write [%s]", file.c_str());
+        return false;
+    }
+    return true;
+}
+
+// i from 0, the oldest row kept.
+const TickProfiler::Row& TickProfiler::rowAt(size_t i) const {
+    const uint64_t kept = std::min<uint64_t>(mTicks, Capacity);
+    return mRows[(mTicks - kept + i) % Capacity];
+}
+
+uint64_t TickProfiler::total(const Row& row) const {
+    uint64_t sum = 0;
+    for (size_t stage = 0; stage < mNames.size(); ++stage) {
+        if (row[stage] != notRun)
+            sum += row[stage];
+    }
+    return sum;
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include "Timer.h"
+#include "Trace.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Times the stages of the script tick. Keeps the last Capacity ticks in a
+// ring, one row of stage durations per tick.
+class TickProfiler {
+public:
+    static constexpr size_t MaxStages = 8;
+    static constexpr size_t Capacity = 1024;
+
+    struct Summary {
+        // Ticks the stage ran in, out of the ones kept.
+        size_t Samples = 0;
+        // Microseconds.
+        double P50 = 0.0;
+        double P99 = 0.0;
+        double Max = 0.0;
+    };
+
+    // Times a stage from construction to destruction, and traces it while
+    // a trace capture runs.
+    class Scope {
+    public:
+        Scope(TickProfiler& profiler, size_t stage)
+            : mTrace(profiler.StageName(stage).c_str())
+            , mProfiler(profiler), mStage(stage), mStart(NowNanos()) {}
+        ~Scope() { mProfiler.Record(mStage, NowNanos() - mStart); }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        Tracing::Scope mTrace;
+        TickProfiler& mProfiler;
+        size_t mStage;
+        int64_t mStart;
+    };
+
+    // Up to MaxStages names, indexed by the stage numbers passed to Record.
+    explicit TickProfiler(std::vector<std::string> stageNames);
+
+    // Starts a new row, stages not recorded in a tick didn't run.
+    void BeginTick();
+    void Record(size_t stage, int64_t nanoseconds);
+    void Reset();
+
+    size_t Stages() const { return mNames.size(); }
+    const std::string& StageName(size_t stage) const { return mNames[stage]; }
+    // Stage numbers from 0 to Stages() - 1, Stages() for the whole tick.
+    Summary Summarize(size_t stage) const;
+
+    // One row per tick, oldest first, in microseconds. Stages that didn't
+    // run are left empty.
+    bool WriteCsv(const std::string& file) const;
+
+private:
+    static constexpr uint32_t notRun = UINT32_MAX;
+    using Row = std::array<uint32_t, MaxStages>;
+
+    const Row& rowAt(size_t i) const;
+    uint64_t total(const Row& row) const;
+
+    std::vector<std::string> mNames;
+    std::vector<Row> mRows;
+    // Ticks since the last Reset, the newest is at (mTicks - 1) % Capacity.
+    uint64_t mTicks = 0;
+};
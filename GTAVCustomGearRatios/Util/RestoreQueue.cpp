@@ -0,0 +1,20 @@
+#include "RestoreQueue.h"
+
+#include <algorithm>
+
+void RestoreQueue::Push(int handle) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    // Only a handful queue up between dispatches, a scan is fine.
+    if (std::find(mPending.begin(), mPending.end(), handle) == mPending.end())
+        mPending.push_back(handle);
+}
+
+bool RestoreQueue::Empty() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mPending.empty();
+}
+
+void RestoreQueue::Clear() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mPending.clear();
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <mutex>
+#include <vector>
+
+// Vehicle handles waiting for their gears to be restored.
+// Push can be called from any thread, so anything that notices a change can
+// feed it. Dispatch is meant for the script thread.
+class RestoreQueue {
+public:
+    // Queues a handle, unless it's queued already.
+    void Push(int handle);
+    bool Empty() const;
+    void Clear();
+
+    // Calls fn(handle) once for each queued handle, in the order they were
+    // pushed, and empties the queue. Handles pushed from fn wait for the
+    // next Dispatch. Returns the number dispatched.
+    template <typename F>
+    size_t Dispatch(F fn) {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mDispatching.swap(mPending);
+        }
+        for (int handle : mDispatching) {
+            fn(handle);
+        }
+        size_t count = mDispatching.size();
+        mDispatching.clear();
+        return count;
+    }
+
+private:
+    mutable std::mutex mMutex;
+    std::vector<int> mPending;
+    // Only touched by Dispatch, kept around for its capacity.
+    std::vector<int> mDispatching;
+};
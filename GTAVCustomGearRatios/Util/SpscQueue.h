@@ -0,0 +1,56 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer
+// thread. Capacity is rounded up to a power of two.
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity)
+            size *= 2;
+        mSlots.resize(size);
+        mMask = size - 1;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer only. False, and value untouched, when full.
+    bool Push(T&& value) {
+        const size_t tail = mTail.load(std::memory_order_relaxed);
+        if (tail - mHead.load(std::memory_order_acquire) > mMask)
+            return false;
+        mSlots[tail & mMask] = std::move(value);
+        mTail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only. False when empty.
+    bool Pop(T& value) {
+        const size_t head = mHead.load(std::memory_order_relaxed);
+        if (head == mTail.load(std::memory_order_acquire))
+            return false;
+        value = std::move(mSlots[head & mMask]);
+        mSlots[head & mMask] = T();
+        mHead.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Either side, but only a snapshot.
+    bool Empty() const {
+        return mHead.load(std::memory_order_acquire) == mTail.load(std::memory_order_acquire);
+    }
+
+private:
+    std::vector<T> mSlots;
+    size_t mMask;
+    // Next slot to pop, owned by the consumer.
+    alignas(64) std::atomic<size_t> mHead{ 0 };
+    // Next slot to push, owned by the producer.
+    alignas(64) std::atomic<size_t> mTail{ 0 };
+};
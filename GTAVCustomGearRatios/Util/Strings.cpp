@@ -42,9 +42,12 @@ std::string StrUtil::replace_chars(std::string s, std::string replaceChars, char
     return s;
 }
 
+std::string StrUtil::normalize(std::string s) {
+    trim(s);
+    return to_lower(std::move(s));
+}
+
 // https://stackoverflow.com/questions/216823/whats-the-best-way-to-trim-stdstring/25385766
 bool StrUtil::loose_match(std::string a, std::string b) {
-    trim(a);
-    trim(b);
-    return to_lower(a) == to_lower(b);
+    return normalize(std::move(a)) == normalize(std::move(b));
 }
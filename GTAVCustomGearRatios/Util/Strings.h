@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <sstream>
@@ -21,11 +22,15 @@ namespace StrUtil {
 
     std::string replace_chars(std::string s, std::string replaceChars, char replacement);
 
+    // Trims leading/trailing spaces and lowercases
+    std::string normalize(std::string s);
+
     // Ignores leading/trailing spaces and case
     bool loose_match(std::string a, std::string b);
 
-    constexpr unsigned long joaat(const char* s) {
-        unsigned long hash = 0;
+    // 32-bit, like the game. unsigned long is wider outside Windows.
+    constexpr uint32_t joaat(const char* s) {
+        uint32_t hash = 0;
         for (; *s != '\0'; ++s) {
             auto c = *s;
             if (c >= 0x41 && c <= 0x5a) {
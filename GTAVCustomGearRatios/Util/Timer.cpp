@@ -32,3 +32,15 @@ int64_t Timer::Elapsed() const {
 int64_t Timer::Period() const {
     return mPeriod;
 }
+
+int64_t NowMicros() {
+    using namespace std::chrono;
+    auto tEpoch = steady_clock::now().time_since_epoch();
+    return duration_cast<microseconds>(tEpoch).count();
+}
+
+int64_t NowNanos() {
+    using namespace std::chrono;
+    auto tEpoch = steady_clock::now().time_since_epoch();
+    return duration_cast<nanoseconds>(tEpoch).count();
+}
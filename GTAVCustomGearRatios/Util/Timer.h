@@ -15,3 +15,8 @@ private:
     int64_t mPeriod;
     int64_t mPreviousTime;
 };
+
+// Monotonic clock in microseconds, for timing short sections.
+int64_t NowMicros();
+// Same clock in nanoseconds, for sections of a few microseconds.
+int64_t NowNanos();
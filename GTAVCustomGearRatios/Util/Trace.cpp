@@ -0,0 +1,146 @@
+#include "Trace.h"
+
+#include "Logger.hpp"
+
+#include <fmt/format.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <memory>
+
+namespace {
+    struct Event {
+        // Generation of the capture it belongs to, once written.
+        std::atomic<uint32_t> Committed{ 0 };
+        uint32_t Thread = 0;
+        const char* Name = nullptr;
+        int64_t Start = 0;
+        int64_t Duration = 0;
+        char Detail[48] = {};
+    };
+
+    std::unique_ptr<Event[]> events;
+    std::atomic<size_t> claimed{ 0 };
+    int64_t origin = 0;
+
+    std::atomic<uint32_t> nextThreadId{ 1 };
+
+    uint32_t threadId() {
+        thread_local uint32_t id = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+    void appendEscaped(std::string& out, const char* text) {
+        for (const char* c = text; *c != '\0'; ++c) {
+            switch (*c) {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                default:
+                    if (static_cast<unsigned char>(*c) < 0x20)
+                        out += fmt::format("\\u{:04x}", static_cast<unsigned>(*c));
+                    else
+                        out += *c;
+            }
+        }
+    }
+}
+
+namespace Tracing {
+    namespace detail {
+        std::atomic<bool> recording{ false };
+        // 0 is never a capture, so zeroed events aren't committed to one.
+        std::atomic<uint32_t> generation{ 0 };
+
+        void record(uint32_t capture, const char* name, const char* text, int64_t start, int64_t end) {
+            // Acquire, events was allocated before recording was set.
+            if (!recording.load(std::memory_order_acquire) || capture != generation.load(std::memory_order_relaxed))
+                return;
+            size_t index = claimed.fetch_add(1, std::memory_order_relaxed);
+            if (index >= Capacity)
+                return;
+
+            Event& event = events[index];
+            event.Thread = threadId();
+            event.Name = name;
+            event.Start = start;
+            event.Duration = end - start;
+            event.Detail[0] = '\0';
+            if (text) {
+                size_t length = strlen(text);
+                size_t skip = length >= sizeof(event.Detail) ? length - (sizeof(event.Detail) - 1) : 0;
+                memcpy(event.Detail, text + skip, length - skip + 1);
+            }
+            event.Committed.store(capture, std::memory_order_release);
+        }
+    }
+
+    void Start() {
+        if (Recording())
+            return;
+        if (!events)
+            events = std::make_unique<Event[]>(Capacity);
+        claimed.store(0, std::memory_order_relaxed);
+        origin = NowNanos();
+        detail::generation.fetch_add(1, std::memory_order_relaxed);
+        detail::recording.store(true, std::memory_order_release);
+        logger.Write(INFO, "[Trace] Capture started");
+    }
+
+    void Stop() {
+        if (!Recording())
+            return;
+        detail::recording.store(false, std::memory_order_release);
+        logger.Write(INFO, "[Trace] Capture stopped, %u events, %u dropped",
+            static_cast<unsigned>(std::min(claimed.load(), Capacity)), static_cast<unsigned>(Dropped()));
+    }
+
+    bool Write(const std::string& file) {
+        if (!events)
+            return false;
+
+        const uint32_t generation = detail::generation.load(std::memory_order_relaxed);
+        const size_t count = std::min(claimed.load(std::memory_order_relaxed), Capacity);
+
+        std::string out;
+        out.reserve(count * 128);
+        out += "{\"traceEvents\":[\n";
+        bool first = true;
+        for (size_t i = 0; i < count; ++i) {
+            const Event& event = events[i];
+            // Still being written when the capture stopped.
+            if (event.Committed.load(std::memory_order_acquire) != generation)
+                continue;
+
+            if (!first)
+                out += ",\n";
+            first = false;
+
+            out += "{\"name\":\"";
+            appendEscaped(out, event.Name);
+            out += fmt::format("\",\"cat\":\"cgr\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":1,\"tid\":{}",
+                static_cast<double>(event.Start - origin) / 1000.0,
+                static_cast<double>(event.Duration) / 1000.0,
+                event.Thread);
+            if (event.Detail[0] != '\0') {
+                out += ",\"args\":{\"detail\":\"";
+                appendEscaped(out, event.Detail);
+                out += "\"}";
+            }
+            out += '}';
+        }
+        out += fmt::format("\n],\"displayTimeUnit\":\"ms\",\"otherData\":{{\"dropped\":{}}}}}\n", Dropped());
+
+        std::ofstream stream(file, std::ios::binary | std::ios::trunc);
+        stream.write(out.data(), static_cast<std::streamsize>(out.size()));
+        if (!stream) {
+            logger.Write(ERROR, "[Trace] Failed to write [%s]", file.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    size_t Dropped() {
+        size_t count = claimed.load(std::memory_order_relaxed);
+        return count > Capacity ? count - Capacity : 0;
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include "Timer.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Records scoped events while a capture runs, and writes them as Chrome
+// trace_event JSON (chrome://tracing, Perfetto). Events go to a fixed
+// buffer, allocated on the first Start. When not recording, a scope is a
+// single relaxed load.
+namespace Tracing {
+    // Events per capture, later ones are dropped.
+    constexpr size_t Capacity = 64 * 1024;
+
+    namespace detail {
+        extern std::atomic<bool> recording;
+        extern std::atomic<uint32_t> generation;
+        void record(uint32_t capture, const char* name, const char* text, int64_t start, int64_t end);
+    }
+
+    inline bool Recording() {
+        return detail::recording.load(std::memory_order_relaxed);
+    }
+
+    // Script thread only.
+    void Start();
+    // Events of scopes that are still open are dropped.
+    void Stop();
+    // Writes the last capture, after Stop.
+    bool Write(const std::string& file);
+    // Events lost in the last capture, to a full buffer.
+    size_t Dropped();
+
+    // An event from construction to destruction. name must be a literal or
+    // outlive the capture, text is copied (its end, when too long).
+    class Scope {
+    public:
+        explicit Scope(const char* name, const char* text = nullptr) {
+            if (Recording()) {
+                mName = name;
+                mText = text;
+                mGeneration = detail::generation.load(std::memory_order_relaxed);
+                mStart = NowNanos();
+            }
+        }
+        ~Scope() {
+            if (mName)
+                detail::record(mGeneration, mName, mText, mStart, NowNanos());
+        }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        const char* mName = nullptr;
+        const char* mText = nullptr;
+        uint32_t mGeneration = 0;
+        int64_t mStart = 0;
+    };
+}
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(...) Tracing::Scope TRACE_CONCAT(traceScope, __LINE__)(__VA_ARGS__)
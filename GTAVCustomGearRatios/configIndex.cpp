@@ -0,0 +1,40 @@
+#include "configIndex.h"
+
+#include "Util/Strings.h"
+
+void ConfigIndex::Build(const std::vector<GearInfo>& configs) {
+    Clear();
+    for (size_t i = 0; i < configs.size(); ++i) {
+        const GearInfo& config = configs[i];
+        const Hash nameHash = static_cast<Hash>(StrUtil::joaat(config.ModelName.c_str()));
+        add(nameHash, i, config);
+        if (config.ModelHash != 0 && config.ModelHash != nameHash)
+            add(config.ModelHash, i, config);
+    }
+}
+
+void ConfigIndex::Clear() {
+    mModels.clear();
+}
+
+size_t ConfigIndex::Find(Hash model, const char* plate) const {
+    auto modelIt = mModels.find(model);
+    if (modelIt == mModels.end())
+        return npos;
+
+    const ModelEntry& entry = modelIt->second;
+    if (plate) {
+        auto plateIt = entry.Plates.find(StrUtil::normalize(plate));
+        if (plateIt != entry.Plates.end())
+            return plateIt->second;
+    }
+    return entry.Generic;
+}
+
+void ConfigIndex::add(Hash model, size_t index, const GearInfo& config) {
+    ModelEntry& entry = mModels[model];
+    // emplace keeps the earlier config for duplicate plates
+    entry.Plates.emplace(StrUtil::normalize(config.LicensePlate), index);
+    if (config.LoadType == LoadType::Model && entry.Generic == npos)
+        entry.Generic = index;
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include "gearInfo.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Finds gear configs by vehicle model and plate, without walking the list.
+// Picks the same config as a front-to-back search of the config list would:
+// the first one with a matching model and plate, otherwise the first
+// model-generic one.
+class ConfigIndex {
+public:
+    static constexpr size_t npos = SIZE_MAX;
+
+    // Needs to be rebuilt when the config list changes.
+    void Build(const std::vector<GearInfo>& configs);
+    void Clear();
+
+    // Returns an index into the configs passed to Build, or npos.
+    // plate may be nullptr, then only model-generic configs match.
+    size_t Find(Hash model, const char* plate) const;
+
+private:
+    struct ModelEntry {
+        // Normalized plate text -> first config with it.
+        std::unordered_map<std::string, size_t> Plates;
+        size_t Generic = npos;
+    };
+
+    void add(Hash model, size_t index, const GearInfo& config);
+
+    std::unordered_map<Hash, ModelEntry> mModels;
+};
@@ -0,0 +1,184 @@
+#include "configLoader.h"
+
+#include "Util/Logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace {
+    // Below this, starting threads costs more than it saves.
+    constexpr size_t minFilesPerThread = 16;
+
+    // Calls fn(i) for 0 <= i < count, spread over up to `threads` threads,
+    // the calling thread included.
+    template <typename F>
+    void parallelFor(size_t count, unsigned threads, F fn) {
+        std::atomic<size_t> next{ 0 };
+        auto worker = [&]() {
+            for (size_t i = next++; i < count; i = next++) {
+                fn(i);
+            }
+        };
+
+        const size_t maxThreads = std::max<size_t>(1, count / minFilesPerThread);
+        const unsigned numThreads = static_cast<unsigned>(std::clamp<size_t>(threads, 1, maxThreads));
+
+        std::vector<std::thread> pool;
+        pool.reserve(numThreads - 1);
+        for (unsigned t = 1; t < numThreads; ++t) {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : pool) {
+            thread.join();
+        }
+    }
+
+    // Whole file into data, with a NUL after it for ParseConfig.
+    bool readFile(const std::string& path, std::vector<char>& data) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file)
+            return false;
+
+        const std::streamoff size = file.tellg();
+        if (size < 0)
+            return false;
+        data.resize(static_cast<size_t>(size) + 1);
+        file.seekg(0);
+        file.read(data.data(), size);
+        data.resize(static_cast<size_t>(file.gcount()) + 1);
+        data.back() = '\0';
+        return true;
+    }
+
+    // FNV-1a
+    uint64_t hashBytes(const char* data, size_t size) {
+        uint64_t hash = 0xCBF29CE484222325ull;
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= static_cast<uint8_t>(data[i]);
+            hash *= 0x100000001B3ull;
+        }
+        return hash;
+    }
+}
+
+bool ConfigManifest::Refresh(const std::string& dir, unsigned threads, Stats& stats) {
+    stats = Stats();
+
+    std::map<std::string, ConfigPack::Item> entries;
+    // Entries that need their contents looked at.
+    std::vector<std::pair<const std::string*, ConfigPack::Item*>> changed;
+
+    std::error_code ec;
+    for (const auto& dirEntry : fs::directory_iterator(dir, ec)) {
+        if (dirEntry.path().extension() != ".xml")
+            continue;
+
+        // On Windows both come with the directory listing, no extra file access.
+        std::error_code statError;
+        const int64_t modifiedTime = dirEntry.last_write_time(statError).time_since_epoch().count();
+        const uintmax_t size = dirEntry.file_size(statError);
+
+        std::string path = dirEntry.path().string();
+        auto oldIt = mEntries.find(path);
+        ConfigPack::Item entry;
+        bool same = false;
+        if (oldIt != mEntries.end()) {
+            entry = std::move(oldIt->second);
+            same = !statError && entry.Stamp.ModifiedTime == modifiedTime && entry.Stamp.Size == size;
+            mEntries.erase(oldIt);
+        }
+        entry.Stamp.ModifiedTime = modifiedTime;
+        entry.Stamp.Size = size;
+
+        auto newIt = entries.emplace(std::move(path), std::move(entry)).first;
+        if (!same) {
+            changed.emplace_back(&newIt->first, &newIt->second);
+        }
+    }
+    if (ec) {
+        LOG_ERROR("Failed to list [{}]: {}", dir, ec.message());
+    }
+
+    // Whatever's left wasn't in the directory anymore.
+    stats.Removed = mEntries.size();
+
+    // New entries have an empty path, so they're always parsed. Each file is
+    // read once, for both the hash and the parse.
+    std::vector<uint8_t> reparsed(changed.size(), 0);
+    parallelFor(changed.size(), threads, [&](size_t i) {
+        const std::string& path = *changed[i].first;
+        ConfigPack::Item& entry = *changed[i].second;
+        std::vector<char> data;
+        const bool read = readFile(path, data);
+        const size_t size = read ? data.size() - 1 : 0;
+        const uint64_t hash = read ? hashBytes(data.data(), size) : 0;
+        if (read && !entry.Info.Path.empty() && hash == entry.Stamp.Hash)
+            return;
+
+        entry.Stamp.Hash = hash;
+        // Unreadable files go through ParseConfig's own error reporting.
+        entry.Info = read ? GearInfo::ParseConfig(path, data.data(), size) : GearInfo::ParseConfig(path);
+        entry.Info.Path = path;
+        reparsed[i] = 1;
+    });
+
+    for (size_t i = 0; i < changed.size(); ++i) {
+        if (!reparsed[i]) {
+            ++stats.Rehashed;
+            continue;
+        }
+        ++stats.Parsed;
+        const ConfigPack::Item& entry = *changed[i].second;
+        if (entry.Info.ParseError) {
+            LOG_ERROR("{} skipped due to errors", fs::path(*changed[i].first).stem().string());
+        }
+    }
+
+    mEntries = std::move(entries);
+    stats.Total = mEntries.size();
+
+    const bool loadedPack = mLoadedPack;
+    mLoadedPack = false;
+    return loadedPack || stats.Parsed > 0 || stats.Removed > 0;
+}
+
+void ConfigManifest::GetConfigs(std::vector<GearInfo>& configs) const {
+    for (const auto& [path, entry] : mEntries) {
+        if (!entry.Info.ParseError) {
+            configs.push_back(entry.Info);
+        }
+    }
+}
+
+void ConfigManifest::Clear() {
+    mEntries.clear();
+}
+
+bool ConfigManifest::LoadPack(const std::string& file) {
+    std::vector<ConfigPack::Item> items;
+    if (!ConfigPack::Load(file, items))
+        return false;
+
+    mEntries.clear();
+    for (auto& item : items) {
+        std::string path = item.Info.Path;
+        mEntries.emplace(std::move(path), std::move(item));
+    }
+    mLoadedPack = true;
+    return true;
+}
+
+bool ConfigManifest::SavePack(const std::string& file) const {
+    std::vector<ConfigPack::Item> items;
+    items.reserve(mEntries.size());
+    for (const auto& [path, entry] : mEntries) {
+        items.push_back(entry);
+    }
+    return ConfigPack::Save(file, items);
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include "gearInfo.h"
+#include "configPack.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// Keeps parsed configs between reloads of the config directory. Refresh only
+// parses files that were added or changed since the last Refresh, so
+// reloading an unchanged directory is just a listing of it.
+class ConfigManifest {
+public:
+    struct Stats {
+        // Added, or changed contents.
+        size_t Parsed = 0;
+        // Modified time or size changed, but the contents didn't.
+        size_t Rehashed = 0;
+        size_t Removed = 0;
+        size_t Total = 0;
+    };
+
+    // Brings the manifest in line with the .xml files directly in dir.
+    // Changed files are read and parsed on up to `threads` threads.
+    // Returns true if any config was added, changed or removed, or the
+    // manifest was loaded from a pack since the last Refresh.
+    bool Refresh(const std::string& dir, unsigned threads, Stats& stats);
+
+    // Appends configs that parsed without errors to configs, sorted by path.
+    void GetConfigs(std::vector<GearInfo>& configs) const;
+
+    void Clear();
+
+    // Replaces the manifest with a configs.cgrpack, so the next Refresh only
+    // parses files that changed since the pack was saved.
+    bool LoadPack(const std::string& file);
+    bool SavePack(const std::string& file) const;
+
+private:
+    // Sorted by path: the first match in the list wins when looking up configs.
+    std::map<std::string, ConfigPack::Item> mEntries;
+    // Entries came from LoadPack, nobody's seen them yet.
+    bool mLoadedPack = false;
+};
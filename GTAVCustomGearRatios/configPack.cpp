@@ -0,0 +1,161 @@
+#include "configPack.h"
+
+#include "Util/Logger.hpp"
+#include "Util/MappedFile.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+namespace {
+    class StringTable {
+    public:
+        uint32_t Add(const std::string& str) {
+            auto it = mOffsets.find(str);
+            if (it != mOffsets.end())
+                return it->second;
+            uint32_t offset = static_cast<uint32_t>(mData.size());
+            mData.insert(mData.end(), str.begin(), str.end());
+            mData.push_back('\0');
+            mOffsets.emplace(str, offset);
+            return offset;
+        }
+
+        const std::vector<char>& Data() const { return mData; }
+
+    private:
+        std::vector<char> mData;
+        std::unordered_map<std::string, uint32_t> mOffsets;
+    };
+}
+
+bool ConfigPack::Save(const std::string& file, const std::vector<Item>& items) {
+    StringTable strings;
+    std::vector<Record> records;
+    records.reserve(items.size());
+
+    for (const auto& item : items) {
+        const GearInfo& info = item.Info;
+        Record record{};
+        record.ModifiedTime = item.Stamp.ModifiedTime;
+        record.FileSize = item.Stamp.Size;
+        record.Hash = item.Stamp.Hash;
+        record.Path = strings.Add(info.Path);
+        record.Description = strings.Add(info.Description);
+        record.ModelName = strings.Add(info.ModelName);
+        record.LicensePlate = strings.Add(info.LicensePlate);
+        record.ModelHash = info.ModelHash;
+        record.DriveMaxVel = info.DriveMaxVel;
+        std::copy(info.Ratios.begin(), info.Ratios.end(), record.Ratios);
+        record.TopGear = info.TopGear;
+        record.NumRatios = static_cast<uint8_t>(info.Ratios.size());
+        record.LoadType = static_cast<uint8_t>(info.LoadType);
+        record.ParseError = info.ParseError ? 1 : 0;
+        records.push_back(record);
+    }
+
+    Header header{};
+    memcpy(header.Magic, Magic, sizeof(Magic));
+    header.Version = Version;
+    header.RecordCount = static_cast<uint32_t>(records.size());
+    header.RecordSize = sizeof(Record);
+    header.StringsOffset = static_cast<uint32_t>(sizeof(Header) + records.size() * sizeof(Record));
+    header.StringsSize = static_cast<uint32_t>(strings.Data().size());
+
+    const std::string tempFile = file + ".tmp";
+    {
+        std::ofstream out(tempFile, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(Record));
+        out.write(strings.Data().data(), strings.Data().size());
+        if (!out) {
+            LOG_ERROR("[Pack] Failed to write [{}]", tempFile);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tempFile, file, ec);
+    if (ec) {
+        LOG_ERROR("[Pack] Failed to replace [{}]: {}", file, ec.message());
+        fs::remove(tempFile, ec);
+        return false;
+    }
+    return true;
+}
+
+bool ConfigPack::Load(const std::string& file, std::vector<Item>& items) {
+    MappedFile mapped;
+    if (!mapped.Open(file))
+        return false;
+
+    const uint8_t* data = mapped.Data();
+    const size_t size = mapped.Size();
+
+    Header header;
+    if (size < sizeof(Header)) {
+        LOG_WARN("[Pack] [{}] too small, ignoring it", file);
+        return false;
+    }
+    memcpy(&header, data, sizeof(Header));
+
+    if (memcmp(header.Magic, Magic, sizeof(Magic)) != 0 ||
+        header.Version != Version ||
+        header.RecordSize != sizeof(Record)) {
+        LOG_WARN("[Pack] [{}] is not a version {} pack, ignoring it", file, Version);
+        return false;
+    }
+
+    const uint64_t recordsEnd = sizeof(Header) + static_cast<uint64_t>(header.RecordCount) * sizeof(Record);
+    const uint64_t stringsEnd = static_cast<uint64_t>(header.StringsOffset) + header.StringsSize;
+    if (recordsEnd > header.StringsOffset || stringsEnd > size ||
+        (header.StringsSize > 0 && data[stringsEnd - 1] != '\0')) {
+        LOG_WARN("[Pack] [{}] is damaged, ignoring it", file);
+        return false;
+    }
+
+    const char* strings = reinterpret_cast<const char*>(data + header.StringsOffset);
+    auto validString = [&](uint32_t offset) {
+        return offset < header.StringsSize;
+    };
+
+    std::vector<Item> loaded;
+    loaded.reserve(header.RecordCount);
+    for (uint32_t i = 0; i < header.RecordCount; ++i) {
+        Record record;
+        memcpy(&record, data + sizeof(Header) + i * sizeof(Record), sizeof(Record));
+
+        if (!validString(record.Path) || !validString(record.Description) ||
+            !validString(record.ModelName) || !validString(record.LicensePlate) ||
+            record.NumRatios > GearSet::Capacity ||
+            // Ratios[TopGear] is read all over, it has to be there.
+            (!record.ParseError && record.TopGear >= record.NumRatios) ||
+            record.LoadType > static_cast<uint8_t>(LoadType::None)) {
+            LOG_WARN("[Pack] [{}] record {} is damaged, ignoring the pack", file, i);
+            return false;
+        }
+
+        Item item;
+        item.Stamp.ModifiedTime = record.ModifiedTime;
+        item.Stamp.Size = record.FileSize;
+        item.Stamp.Hash = record.Hash;
+        if (!record.ParseError) {
+            item.Info = GearInfo(strings + record.Description,
+                strings + record.ModelName,
+                record.ModelHash,
+                strings + record.LicensePlate,
+                record.TopGear,
+                record.DriveMaxVel,
+                GearSet(record.Ratios, record.NumRatios),
+                static_cast<LoadType>(record.LoadType));
+        }
+        item.Info.Path = strings + record.Path;
+        loaded.push_back(std::move(item));
+    }
+
+    items = std::move(loaded);
+    return true;
+}
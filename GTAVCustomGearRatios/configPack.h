@@ -0,0 +1,69 @@
+#pragma once
+#include "gearInfo.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// configs.cgrpack: parsed gear configs, and the stamps of the XML files they
+// were parsed from, so startup only has to parse what changed since.
+//
+// Layout, little-endian:
+//   Header
+//   Record[RecordCount]
+//   String table: NUL-terminated strings, Record string fields are offsets
+//   into it.
+namespace ConfigPack {
+    constexpr char Magic[4] = { 'C', 'G', 'R', 'P' };
+    constexpr uint32_t Version = 1;
+
+    struct Header {
+        char Magic[4];
+        uint32_t Version;
+        uint32_t RecordCount;
+        uint32_t RecordSize;
+        uint32_t StringsOffset;
+        uint32_t StringsSize;
+    };
+    static_assert(sizeof(Header) == 24, "Header layout changed");
+
+    struct Record {
+        int64_t ModifiedTime;
+        uint64_t FileSize;
+        uint64_t Hash;
+        uint32_t Path;
+        uint32_t Description;
+        uint32_t ModelName;
+        uint32_t LicensePlate;
+        uint32_t ModelHash;
+        float DriveMaxVel;
+        float Ratios[GearSet::Capacity];
+        uint8_t TopGear;
+        uint8_t NumRatios;
+        uint8_t LoadType;
+        uint8_t ParseError;
+    };
+    static_assert(sizeof(Record) == 96, "Record layout changed");
+
+    // What a config file looked like when it was parsed.
+    struct FileStamp {
+        int64_t ModifiedTime = 0;
+        uintmax_t Size = 0;
+        // FNV-1a of the contents.
+        uint64_t Hash = 0;
+    };
+
+    // Info.Path is the file it came from. Configs that failed to parse are
+    // kept too (ParseError set), so they aren't parsed again until changed.
+    struct Item {
+        FileStamp Stamp;
+        GearInfo Info;
+    };
+
+    // Writes to a temporary file first, then replaces file.
+    bool Save(const std::string& file, const std::vector<Item>& items);
+
+    // Replaces items with the pack contents. False, and items untouched, if
+    // the file is missing, from another version, or damaged.
+    bool Load(const std::string& file, std::vector<Item>& items);
+}
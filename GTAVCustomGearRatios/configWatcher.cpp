@@ -0,0 +1,247 @@
+#include "configWatcher.h"
+
+#include "Util/Logger.hpp"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    // Editors and file copies touch a file several times, wait for it to
+    // settle before reloading.
+    constexpr int coalesceMs = 250;
+    // Retry interval for a config set that didn't fit in the queue.
+    constexpr int resendMs = 100;
+}
+
+#ifdef _WIN32
+struct ConfigWatcher::Platform {
+    HANDLE Directory = INVALID_HANDLE_VALUE;
+    HANDLE StopEvent = nullptr;
+    OVERLAPPED Overlapped{};
+    bool Pending = false;
+    std::vector<DWORD> Buffer = std::vector<DWORD>(4096);
+};
+
+bool ConfigWatcher::openWatch() {
+    mPlatform->Directory = CreateFileA(mDir.c_str(), FILE_LIST_DIRECTORY,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+        FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+    if (mPlatform->Directory == INVALID_HANDLE_VALUE) {
+        LOG_ERROR("[Watcher] Failed to open [{}], error {}", mDir, GetLastError());
+        return false;
+    }
+    mPlatform->StopEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+    mPlatform->Overlapped.hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+    return mPlatform->StopEvent && mPlatform->Overlapped.hEvent;
+}
+
+void ConfigWatcher::closeWatch() {
+    Platform& p = *mPlatform;
+    if (p.Pending) {
+        DWORD bytes = 0;
+        CancelIoEx(p.Directory, &p.Overlapped);
+        GetOverlappedResult(p.Directory, &p.Overlapped, &bytes, TRUE);
+        p.Pending = false;
+    }
+    if (p.Directory != INVALID_HANDLE_VALUE)
+        CloseHandle(p.Directory);
+    if (p.StopEvent)
+        CloseHandle(p.StopEvent);
+    if (p.Overlapped.hEvent)
+        CloseHandle(p.Overlapped.hEvent);
+    p = Platform();
+}
+
+ConfigWatcher::WaitResult ConfigWatcher::waitForChange(int timeoutMs) {
+    Platform& p = *mPlatform;
+    if (!p.Pending) {
+        const DWORD filter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE;
+        if (!ReadDirectoryChangesW(p.Directory, p.Buffer.data(), static_cast<DWORD>(p.Buffer.size() * sizeof(DWORD)),
+            FALSE, filter, nullptr, &p.Overlapped, nullptr)) {
+            LOG_ERROR("[Watcher] ReadDirectoryChangesW failed, error {}", GetLastError());
+            return WaitResult::Error;
+        }
+        p.Pending = true;
+    }
+
+    HANDLE handles[] = { p.Overlapped.hEvent, p.StopEvent };
+    switch (WaitForMultipleObjects(2, handles, FALSE, timeoutMs < 0 ? INFINITE : static_cast<DWORD>(timeoutMs))) {
+        case WAIT_OBJECT_0: {
+            // Which files changed doesn't matter, ConfigManifest::Refresh
+            // finds out. An overflow (0 bytes) is just a change too.
+            DWORD bytes = 0;
+            GetOverlappedResult(p.Directory, &p.Overlapped, &bytes, FALSE);
+            p.Pending = false;
+            return WaitResult::Change;
+        }
+        case WAIT_OBJECT_0 + 1:
+            return WaitResult::Stop;
+        case WAIT_TIMEOUT:
+            return WaitResult::Timeout;
+        default:
+            return WaitResult::Error;
+    }
+}
+
+void ConfigWatcher::signalStop() {
+    SetEvent(mPlatform->StopEvent);
+}
+#else
+struct ConfigWatcher::Platform {
+    int Inotify = -1;
+    int StopPipe[2] = { -1, -1 };
+};
+
+bool ConfigWatcher::openWatch() {
+    Platform& p = *mPlatform;
+    p.Inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (p.Inotify < 0 || pipe(p.StopPipe) != 0) {
+        LOG_ERROR("[Watcher] Failed to set up inotify");
+        return false;
+    }
+    const uint32_t mask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO;
+    if (inotify_add_watch(p.Inotify, mDir.c_str(), mask) < 0) {
+        LOG_ERROR("[Watcher] Failed to watch [{}]", mDir);
+        return false;
+    }
+    return true;
+}
+
+void ConfigWatcher::closeWatch() {
+    Platform& p = *mPlatform;
+    for (int fd : { p.Inotify, p.StopPipe[0], p.StopPipe[1] }) {
+        if (fd >= 0)
+            close(fd);
+    }
+    p = Platform();
+}
+
+ConfigWatcher::WaitResult ConfigWatcher::waitForChange(int timeoutMs) {
+    Platform& p = *mPlatform;
+    pollfd fds[] = {
+        { p.Inotify, POLLIN, 0 },
+        { p.StopPipe[0], POLLIN, 0 },
+    };
+    int ready = poll(fds, 2, timeoutMs);
+    if (ready < 0)
+        return errno == EINTR ? WaitResult::Timeout : WaitResult::Error;
+    if (ready == 0)
+        return WaitResult::Timeout;
+    if (fds[1].revents != 0)
+        return WaitResult::Stop;
+
+    // Only that something changed matters, drain the events.
+    alignas(inotify_event) char buffer[4096];
+    while (read(p.Inotify, buffer, sizeof(buffer)) > 0) {}
+    return WaitResult::Change;
+}
+
+void ConfigWatcher::signalStop() {
+    const char stop = 1;
+    (void)!write(mPlatform->StopPipe[1], &stop, 1);
+}
+#endif
+
+ConfigWatcher::ConfigWatcher()
+    : mPlatform(std::make_unique<Platform>())
+    , mUpdates(4) {}
+
+ConfigWatcher::~ConfigWatcher() {
+    Stop();
+}
+
+bool ConfigWatcher::Start(const std::string& dir, ConfigManifest& manifest, const std::string& packFile, unsigned threads) {
+    Stop();
+
+    mDir = dir;
+    mPackFile = packFile;
+    mManifest = &manifest;
+    mThreads = threads;
+    mHasUnsent = false;
+
+    if (!openWatch()) {
+        closeWatch();
+        return false;
+    }
+
+    mThread = std::thread(&ConfigWatcher::run, this);
+    LOG_DEBUG("[Watcher] Watching [{}]", mDir);
+    return true;
+}
+
+void ConfigWatcher::Stop() {
+    if (!mThread.joinable())
+        return;
+    signalStop();
+    mThread.join();
+    closeWatch();
+    // Sets made before Stop would overwrite later reloads if polled.
+    std::vector<GearInfo> stale;
+    while (mUpdates.Pop(stale)) {}
+    mUnsent.clear();
+    mHasUnsent = false;
+    LOG_DEBUG("[Watcher] Stopped");
+}
+
+bool ConfigWatcher::Poll(std::vector<GearInfo>& configs) {
+    bool updated = false;
+    std::vector<GearInfo> update;
+    // Each set is complete, only the newest one matters.
+    while (mUpdates.Pop(update)) {
+        configs = std::move(update);
+        updated = true;
+    }
+    return updated;
+}
+
+void ConfigWatcher::run() {
+    // Catch whatever changed between the last reload and Start.
+    refresh();
+
+    while (true) {
+        WaitResult result = waitForChange(mHasUnsent ? resendMs : -1);
+        if (result == WaitResult::Stop || result == WaitResult::Error)
+            break;
+        if (result == WaitResult::Timeout) {
+            trySend();
+            continue;
+        }
+
+        while ((result = waitForChange(coalesceMs)) == WaitResult::Change) {}
+        if (result == WaitResult::Stop || result == WaitResult::Error)
+            break;
+
+        refresh();
+    }
+}
+
+void ConfigWatcher::refresh() {
+    ConfigManifest::Stats stats;
+    bool changed = mManifest->Refresh(mDir, mThreads, stats);
+    if (changed || stats.Rehashed > 0) {
+        mManifest->SavePack(mPackFile);
+    }
+    if (!changed)
+        return;
+
+    LOG_DEBUG("[Watcher] Configs changed: {} parsed, {} removed, {} total",
+        stats.Parsed, stats.Removed, stats.Total);
+
+    mUnsent.clear();
+    mManifest->GetConfigs(mUnsent);
+    mHasUnsent = true;
+    trySend();
+}
+
+void ConfigWatcher::trySend() {
+    if (mHasUnsent && mUpdates.Push(std::move(mUnsent))) {
+        mUnsent = std::vector<GearInfo>();
+        mHasUnsent = false;
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include "configLoader.h"
+#include "gearInfo.h"
+#include "Util/SpscQueue.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Watches the config directory on a background thread, and reloads it there
+// when files change, so new and edited presets go live without the menu
+// being opened and without parsing on the script thread.
+class ConfigWatcher {
+public:
+    ConfigWatcher();
+    ~ConfigWatcher();
+
+    // While running, manifest belongs to the watcher thread: it's refreshed
+    // there, and packFile is saved after changes. Don't touch either until Stop.
+    bool Start(const std::string& dir, ConfigManifest& manifest, const std::string& packFile, unsigned threads);
+    void Stop();
+    bool Running() const { return mThread.joinable(); }
+
+    // Script thread. Moves the newest config set into configs, if the
+    // directory changed since the last call. Sets not polled before Stop
+    // are dropped.
+    bool Poll(std::vector<GearInfo>& configs);
+
+private:
+    enum class WaitResult {
+        Change,
+        Timeout,
+        Stop,
+        Error,
+    };
+
+    // Platform specific, in the .cpp.
+    struct Platform;
+    bool openWatch();
+    void closeWatch();
+    // Negative timeout waits until something happens.
+    WaitResult waitForChange(int timeoutMs);
+    void signalStop();
+
+    void run();
+    void refresh();
+    void trySend();
+
+    std::unique_ptr<Platform> mPlatform;
+    std::thread mThread;
+
+    std::string mDir;
+    std::string mPackFile;
+    ConfigManifest* mManifest = nullptr;
+    unsigned mThreads = 1;
+
+    // Complete config sets, sorted like ConfigManifest::GetConfigs.
+    SpscQueue<std::vector<GearInfo>> mUpdates;
+    // Newest set, if the queue was full when it was made.
+    std::vector<GearInfo> mUnsent;
+    bool mHasUnsent = false;
+};
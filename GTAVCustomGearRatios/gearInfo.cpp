@@ -1,18 +1,458 @@
 #include "gearInfo.h"
+#include <array>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <utility>
 #include <pugixml/pugixml.hpp>
 #include <fmt/core.h>
 
 #include "Util/Logger.hpp"
+#include "Util/Trace.h"
 
 using namespace pugi;
 
 #define VERIFY_NODE(file, node, name) \
     if (!(node)) {\
-        logger.Write(ERROR, "[XML %s] Missing node [%s]", (file), (name));\
+        LOG_ERROR("[XML {}] Missing node [{}]", (file), (name));\
         return GearInfo();\
     }
 
+namespace {
+    // Files up to this size are read without building a DOM.
+    constexpr size_t streamBufferSize = 16 * 1024;
+
+    // Text of the nodes ParseConfig reads, nullptr for missing nodes.
+    struct ConfigText {
+        bool HasVehicle = false;
+        const char* Description = nullptr;
+        const char* ModelName = nullptr;
+        const char* ModelHash = nullptr;
+        const char* PlateText = nullptr;
+        const char* TopGear = nullptr;
+        const char* DriveMaxVel = nullptr;
+        const char* Gears[GearSet::Capacity] = {};
+    };
+
+    enum class Tag : uint8_t {
+        Other,
+        Vehicle,
+        Description,
+        ModelName,
+        ModelHash,
+        PlateText,
+        TopGear,
+        DriveMaxVel,
+        Gear,
+    };
+
+    struct TagName {
+        const char* Name = nullptr;
+        size_t Length = 0;
+        Tag Id = Tag::Other;
+    };
+
+    // Perfect for the tag names below, checked when building the table.
+    constexpr size_t tagHash(const char* name, size_t length) {
+        return (length * 2 + static_cast<uint8_t>(name[length - 1])) & 15;
+    }
+
+    constexpr size_t length(const char* s) {
+        size_t n = 0;
+        while (s[n] != '\0')
+            ++n;
+        return n;
+    }
+
+    constexpr auto tagTable = [] {
+        std::array<TagName, 16> table{};
+        const TagName names[] = {
+            { "Vehicle", length("Vehicle"), Tag::Vehicle },
+            { "Description", length("Description"), Tag::Description },
+            { "ModelName", length("ModelName"), Tag::ModelName },
+            { "ModelHash", length("ModelHash"), Tag::ModelHash },
+            { "PlateText", length("PlateText"), Tag::PlateText },
+            { "TopGear", length("TopGear"), Tag::TopGear },
+            { "DriveMaxVel", length("DriveMaxVel"), Tag::DriveMaxVel },
+        };
+        for (const auto& name : names) {
+            auto& slot = table[tagHash(name.Name, name.Length)];
+            if (slot.Name != nullptr)
+                throw "tagHash collision";
+            slot = name;
+        }
+        return table;
+    }();
+
+    // Gear0 to Gear10 come back as Tag::Gear, with the number in gear.
+    Tag lookupTag(const char* name, size_t nameLength, uint8_t& gear) {
+        if (nameLength >= 5 && nameLength <= 6 && memcmp(name, "Gear", 4) == 0) {
+            unsigned value = 0;
+            for (size_t i = 4; i < nameLength; ++i) {
+                if (name[i] < '0' || name[i] > '9')
+                    return Tag::Other;
+                value = value * 10 + (name[i] - '0');
+            }
+            // No leading zeros, "Gear01" is another node.
+            if (nameLength == 6 && name[4] == '0')
+                return Tag::Other;
+            if (value >= GearSet::Capacity)
+                return Tag::Other;
+            gear = static_cast<uint8_t>(value);
+            return Tag::Gear;
+        }
+
+        const TagName& entry = tagTable[tagHash(name, nameLength)];
+        if (entry.Length == nameLength && memcmp(entry.Name, name, nameLength) == 0)
+            return entry.Id;
+        return Tag::Other;
+    }
+
+    const char** textSlot(ConfigText& text, Tag tag, uint8_t gear) {
+        switch (tag) {
+            case Tag::Description: return &text.Description;
+            case Tag::ModelName: return &text.ModelName;
+            case Tag::ModelHash: return &text.ModelHash;
+            case Tag::PlateText: return &text.PlateText;
+            case Tag::TopGear: return &text.TopGear;
+            case Tag::DriveMaxVel: return &text.DriveMaxVel;
+            case Tag::Gear: return &text.Gears[gear];
+            default: return nullptr;
+        }
+    }
+
+    // Conversions as pugixml's xml_text does them, so both paths agree.
+    bool isSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    unsigned int toInteger(const char* value, unsigned int minv, unsigned int maxv) {
+        unsigned int result = 0;
+        const char* s = value;
+        while (isSpace(*s))
+            s++;
+
+        bool negative = *s == '-';
+        s += (*s == '+' || *s == '-');
+
+        bool overflow;
+        if (s[0] == '0' && (s[1] | ' ') == 'x') {
+            s += 2;
+            while (*s == '0')
+                s++;
+            const char* start = s;
+            for (;;) {
+                if (static_cast<unsigned>(*s - '0') < 10)
+                    result = result * 16 + (*s - '0');
+                else if (static_cast<unsigned>((*s | ' ') - 'a') < 6)
+                    result = result * 16 + ((*s | ' ') - 'a' + 10);
+                else
+                    break;
+                s++;
+            }
+            overflow = static_cast<size_t>(s - start) > sizeof(unsigned int) * 2;
+        }
+        else {
+            while (*s == '0')
+                s++;
+            const char* start = s;
+            for (;;) {
+                if (static_cast<unsigned>(*s - '0') < 10)
+                    result = result * 10 + (*s - '0');
+                else
+                    break;
+                s++;
+            }
+            const size_t digits = static_cast<size_t>(s - start);
+            overflow = digits >= 10 && !(digits == 10 && (*start < '4' || (*start == '4' && result >> 31)));
+        }
+
+        if (negative)
+            return (overflow || result > 0 - minv) ? minv : 0 - result;
+        return (overflow || result > maxv) ? maxv : result;
+    }
+
+    int toInt(const char* value) {
+        return static_cast<int>(toInteger(value, static_cast<unsigned int>(INT_MIN), INT_MAX));
+    }
+
+    unsigned int toUint(const char* value) {
+        return toInteger(value, 0, UINT_MAX);
+    }
+
+    float toFloat(const char* value) {
+        return static_cast<float>(strtod(value, nullptr));
+    }
+
+    bool isNameStart(char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == ':' ||
+            static_cast<uint8_t>(c) >= 0x80;
+    }
+
+    bool isNameChar(char c) {
+        return isNameStart(c) || (c >= '0' && c <= '9') || c == '-' || c == '.';
+    }
+
+    // Single pass over a config file in data (size bytes, NUL-terminated).
+    // Only takes plain documents it reads exactly like pugixml does: no
+    // attributes, entities, CDATA, DOCTYPE, or markup inside the nodes it
+    // reads. Returns false for anything else, which then goes through pugixml,
+    // also for its error reporting.
+    bool parseStreaming(char* data, size_t size, ConfigText& text) {
+        char* p = data;
+        char* const end = data + size;
+        if (memchr(data, '\0', size) != nullptr)
+            return false;
+
+        if (size >= 3 && memcmp(p, "\xEF\xBB\xBF", 3) == 0)
+            p += 3;
+
+        struct Element {
+            const char* Name;
+            size_t Length;
+            Tag Id;
+        };
+        constexpr size_t maxDepth = 16;
+        Element stack[maxDepth];
+        size_t depth = 0;
+        bool rootSeen = false;
+
+        // Node text ends are NUL-terminated once everything is read.
+        struct Span {
+            char* Begin;
+            char* End;
+            const char** Target;
+        };
+        Span spans[6 + GearSet::Capacity];
+        size_t numSpans = 0;
+        static const char empty[] = "";
+
+        auto startsWith = [&](const char* prefix, size_t prefixLength) {
+            return static_cast<size_t>(end - p) >= prefixLength && memcmp(p, prefix, prefixLength) == 0;
+        };
+
+        auto readName = [&](const char*& name, size_t& nameLength) {
+            if (p == end || !isNameStart(*p))
+                return false;
+            name = p;
+            while (p != end && isNameChar(*p))
+                ++p;
+            nameLength = static_cast<size_t>(p - name);
+            while (p != end && isSpace(*p))
+                ++p;
+            return true;
+        };
+
+        while (p != end) {
+            if (*p != '<') {
+                char* textBegin = p;
+                while (p != end && *p != '<')
+                    ++p;
+                // Text outside nodes that are read doesn't matter, but at
+                // document level only whitespace is plain.
+                if (depth == 0) {
+                    for (char* c = textBegin; c != p; ++c) {
+                        if (!isSpace(*c))
+                            return false;
+                    }
+                }
+                continue;
+            }
+
+            if (startsWith("<!--", 4)) {
+                const char* close = strstr(p + 4, "-->");
+                if (close == nullptr)
+                    return false;
+                p = const_cast<char*>(close) + 3;
+                continue;
+            }
+
+            if (startsWith("<?", 2)) {
+                if (rootSeen)
+                    return false;
+                const char* close = strstr(p + 2, "?>");
+                if (close == nullptr)
+                    return false;
+                p = const_cast<char*>(close) + 2;
+                continue;
+            }
+
+            if (startsWith("<!", 2))
+                return false;
+
+            if (startsWith("</", 2)) {
+                p += 2;
+                const char* name;
+                size_t nameLength;
+                if (!readName(name, nameLength) || p == end || *p != '>' || depth == 0)
+                    return false;
+                const Element& open = stack[depth - 1];
+                if (open.Length != nameLength || memcmp(open.Name, name, nameLength) != 0)
+                    return false;
+                --depth;
+                ++p;
+                continue;
+            }
+
+            // Start tag
+            ++p;
+            const char* name;
+            size_t nameLength;
+            if (!readName(name, nameLength) || p == end)
+                return false;
+            bool selfClosing = false;
+            if (*p == '/') {
+                selfClosing = true;
+                ++p;
+            }
+            if (p == end || *p != '>')
+                return false;
+            ++p;
+
+            uint8_t gear = 0;
+            Tag id = Tag::Other;
+            if (depth == 0) {
+                if (rootSeen)
+                    return false;
+                rootSeen = true;
+                id = lookupTag(name, nameLength, gear);
+                if (id == Tag::Vehicle)
+                    text.HasVehicle = true;
+                else
+                    id = Tag::Other;
+            }
+            else if (depth == 1 && stack[0].Id == Tag::Vehicle) {
+                id = lookupTag(name, nameLength, gear);
+            }
+
+            // Only the first node of each name counts.
+            const char** target = textSlot(text, id, gear);
+            if (target != nullptr && *target != nullptr)
+                target = nullptr;
+
+            if (selfClosing) {
+                if (target != nullptr)
+                    *target = empty;
+                continue;
+            }
+
+            if (depth == maxDepth)
+                return false;
+            stack[depth++] = { name, nameLength, id };
+
+            if (target != nullptr) {
+                // Plain text straight up to the end tag.
+                char* textBegin = p;
+                bool whitespace = true;
+                while (p != end && *p != '<') {
+                    if (*p == '&' || *p == '\r')
+                        return false;
+                    whitespace = whitespace && isSpace(*p);
+                    ++p;
+                }
+                if (!startsWith("</", 2))
+                    return false;
+                // pugixml drops whitespace-only text.
+                *target = empty;
+                if (!whitespace)
+                    spans[numSpans++] = { textBegin, p, target };
+            }
+        }
+
+        if (!rootSeen || depth != 0)
+            return false;
+
+        for (size_t i = 0; i < numSpans; ++i) {
+            *spans[i].End = '\0';
+            *spans[i].Target = spans[i].Begin;
+        }
+        return true;
+    }
+
+    // Same as parseStreaming, from a pugixml document.
+    void readDocument(const xml_document& doc, ConfigText& text) {
+        xml_node vehicleNode = doc.child("Vehicle");
+        if (!vehicleNode)
+            return;
+        text.HasVehicle = true;
+
+        for (xml_node node : vehicleNode.children()) {
+            if (node.type() != node_element)
+                continue;
+            const char* name = node.name();
+            uint8_t gear = 0;
+            Tag id = lookupTag(name, strlen(name), gear);
+            const char** target = textSlot(text, id, gear);
+            if (target != nullptr && *target == nullptr)
+                *target = node.text().get();
+        }
+    }
+
+    GearInfo buildConfig(const std::string& file, const ConfigText& text) {
+        const char* fileName = file.c_str();
+        VERIFY_NODE(fileName, text.HasVehicle, "Vehicle");
+        VERIFY_NODE(fileName, text.Description, "Description");
+        VERIFY_NODE(fileName, text.ModelName, "ModelName");
+        if (!text.ModelHash) {
+            LOG_WARN("[XML {}] Missing node [ModelHash]", fileName);
+        }
+        VERIFY_NODE(fileName, text.PlateText, "PlateText");
+        VERIFY_NODE(fileName, text.TopGear, "TopGear");
+        VERIFY_NODE(fileName, text.DriveMaxVel, "DriveMaxVel");
+
+        int topGearValue = toInt(text.TopGear);
+        if (topGearValue < 1 || topGearValue >= GearSet::Capacity) {
+            LOG_ERROR("[XML {}] TopGear {} out of range (1 to {})",
+                fileName, topGearValue, GearSet::Capacity - 1);
+            return GearInfo();
+        }
+
+        uint8_t topGear = static_cast<uint8_t>(topGearValue);
+        GearSet ratios;
+        ratios.resize(topGear + 1);
+        for (uint8_t gear = 0; gear <= topGear; ++gear) {
+            if (!text.Gears[gear]) {
+                LOG_ERROR("[XML {}] Missing node [Gear{}]", fileName, gear);
+                return GearInfo();
+            }
+            ratios[gear] = toFloat(text.Gears[gear]);
+        }
+
+        enum class LoadType loadType = LoadType::Plate;
+
+        if (text.PlateText == LoadName::None)
+            loadType = LoadType::None;
+        if (text.PlateText == LoadName::Model)
+            loadType = LoadType::Model;
+
+        return GearInfo(
+            text.Description,
+            text.ModelName,
+            text.ModelHash ? toUint(text.ModelHash) : 0,
+            text.PlateText,
+            topGear,
+            toFloat(text.DriveMaxVel),
+            ratios,
+            loadType
+        );
+    }
+
+    // Config from a document pugixml loaded, logging why if it didn't.
+    GearInfo parseDocument(const std::string& file, const xml_document& doc, const xml_parse_result& result) {
+        if (!result) {
+            LOG_ERROR("XML [{}] parsed with errors", file);
+            LOG_ERROR("    Error: {}", result.description());
+            LOG_ERROR("    Offset: {}", result.offset);
+            return GearInfo();
+        }
+
+        ConfigText text;
+        readDocument(doc, text);
+        return buildConfig(file, text);
+    }
+}
+
 GearInfo::GearInfo()
     : Description("Default Ctor - parsing error")
     , ModelHash(0)
@@ -23,85 +463,46 @@ GearInfo::GearInfo()
     , MarkedForDeletion(true) {}
 
 GearInfo::GearInfo(std::string description, std::string modelName, Hash hash, std::string licensePlate,
-                   uint8_t topGear, float driveMaxVel, std::vector<float> ratios, enum class LoadType loadType)
+                   uint8_t topGear, float driveMaxVel, GearSet ratios, enum class LoadType loadType)
     : Description(std::move(description))
     , ModelName(std::move(modelName))
     , ModelHash(hash)
     , LicensePlate(std::move(licensePlate))
     , TopGear(topGear)
     , DriveMaxVel(driveMaxVel)
-    , Ratios(std::move(ratios))
+    , Ratios(ratios)
     , ParseError(false)
     , LoadType(loadType)
     , MarkedForDeletion(false) {}
 
 GearInfo GearInfo::ParseConfig(const std::string& file) {
+    TRACE_SCOPE("ParseConfig", file.c_str());
+    // Most configs are small and plain, read those in one pass.
+    char buffer[streamBufferSize + 1];
+    if (FILE* f = fopen(file.c_str(), "rb")) {
+        size_t size = fread(buffer, 1, sizeof(buffer), f);
+        fclose(f);
+        if (size <= streamBufferSize) {
+            buffer[size] = '\0';
+            ConfigText text;
+            if (parseStreaming(buffer, size, text))
+                return buildConfig(file, text);
+        }
+    }
+
+    xml_document doc;
+    return parseDocument(file, doc, doc.load_file(file.c_str()));
+}
+
+GearInfo GearInfo::ParseConfig(const std::string& file, char* data, size_t size) {
+    TRACE_SCOPE("ParseConfig", file.c_str());
+    ConfigText text;
+    if (parseStreaming(data, size, text))
+        return buildConfig(file, text);
+
+    // Left as it was when streaming gives up.
     xml_document doc;
-    xml_parse_result result = doc.load_file(file.c_str());
-
-    if (!result) {
-        logger.Write(ERROR, "XML [%s] parsed with errors", file.c_str());
-        logger.Write(ERROR, "    Error: %s", result.description());
-        logger.Write(ERROR, "    Offset: %td", result.offset);
-        return GearInfo();
-    }
-
-    xml_node vehicleNode = doc.child("Vehicle");
-    VERIFY_NODE(file.c_str(), vehicleNode, "Vehicle");
-
-    std::string nodeName = "Description";
-    xml_node descriptionNode = vehicleNode.child(nodeName.c_str());
-    VERIFY_NODE(file.c_str(), descriptionNode, nodeName.c_str());
-
-    nodeName = "ModelName";
-    xml_node modelNameNode = vehicleNode.child("ModelName");
-    VERIFY_NODE(file.c_str(), modelNameNode, "ModelName");
-
-    nodeName = "ModelHash";
-    xml_node modelHashNode = vehicleNode.child("ModelHash");
-    if (!modelHashNode) {
-        logger.Write(WARN, "[XML %s] Missing node [%s]", file.c_str(), nodeName.c_str()); \
-    }
-
-    nodeName = "PlateText";
-    xml_node plateTextNode = vehicleNode.child("PlateText");
-    VERIFY_NODE(file.c_str(), plateTextNode, "PlateText");
-
-    nodeName = "TopGear";
-    xml_node topGearNode = vehicleNode.child("TopGear");
-    VERIFY_NODE(file.c_str(), topGearNode, "TopGear");
-
-    nodeName = "DriveMaxVel";
-    xml_node driveMaxVelNode = vehicleNode.child("DriveMaxVel");
-    VERIFY_NODE(file.c_str(), driveMaxVelNode, "DriveMaxVel");
-
-    uint8_t topGear = topGearNode.text().as_int();
-    float driveMaxVel = driveMaxVelNode.text().as_float();
-    std::vector<float> ratios(topGear + 1);
-    for (uint8_t gear = 0; gear <= topGear; ++gear) {
-        nodeName = fmt::format("Gear{}", gear);
-        xml_node gearNode = vehicleNode.child(nodeName.c_str());
-        VERIFY_NODE(file.c_str(), gearNode, nodeName.c_str());
-        ratios[gear] = gearNode.text().as_float();
-    }
-
-    enum class LoadType loadType = LoadType::Plate;
-
-    if (plateTextNode.text().as_string() == LoadName::None)
-        loadType = LoadType::None;
-    if (plateTextNode.text().as_string() == LoadName::Model)
-        loadType = LoadType::Model;
-
-    return GearInfo(
-        descriptionNode.text().as_string(),
-        modelNameNode.text().as_string(),
-        modelHashNode ? modelHashNode.text().as_uint() : 0,
-        plateTextNode.text().as_string(),
-        topGear,
-        driveMaxVel,
-        ratios,
-        loadType
-    );
+    return parseDocument(file, doc, doc.load_buffer(data, size));
 }
 
 void GearInfo::SaveConfig(const GearInfo& gearInfo, const std::string& file) {
@@ -1,7 +1,9 @@
 #pragma once
-#include <inc/natives.h>
+#include <inc/types.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <string>
-#include <vector>
 
 enum class LoadType {
     Plate,
@@ -14,13 +16,51 @@ namespace LoadName {
     static std::string None    = "undefined";
 }
 
+// Gear ratios, reverse (0) up to the top gear.
+// Fixed capacity, so it's copied around without allocating.
+class GearSet {
+public:
+    // Reverse + 10 forward gears (b1604+).
+    static constexpr uint8_t Capacity = 11;
+
+    GearSet() = default;
+    // Takes up to Capacity ratios.
+    GearSet(const float* ratios, size_t count) {
+        resize(count);
+        std::copy(ratios, ratios + mCount, mRatios.begin());
+    }
+
+    size_t size() const { return mCount; }
+    bool empty() const { return mCount == 0; }
+    // Clamps to Capacity. New ratios are 0.
+    void resize(size_t count) {
+        const uint8_t newCount = static_cast<uint8_t>(std::min<size_t>(count, Capacity));
+        std::fill(mRatios.begin() + mCount, mRatios.begin() + std::max(mCount, newCount), 0.0f);
+        mCount = newCount;
+    }
+
+    float* data() { return mRatios.data(); }
+    const float* data() const { return mRatios.data(); }
+    float& operator[](size_t gear) { return mRatios[gear]; }
+    const float& operator[](size_t gear) const { return mRatios[gear]; }
+    const float* begin() const { return mRatios.data(); }
+    const float* end() const { return mRatios.data() + mCount; }
+
+private:
+    std::array<float, Capacity> mRatios{};
+    uint8_t mCount = 0;
+};
+
 struct GearInfo {
     static GearInfo ParseConfig(const std::string& file);
+    // Same, from the file's contents read already: size bytes in data, then
+    // a NUL. data is changed. file is only used for logging.
+    static GearInfo ParseConfig(const std::string& file, char* data, size_t size);
     static void SaveConfig(const GearInfo& gearInfo, const std::string& file);
 
     GearInfo();
     GearInfo(std::string description, std::string modelName, Hash hash, std::string licensePlate,
-        uint8_t topGear, float driveMaxVel, std::vector<float> ratios, enum class LoadType loadType);
+        uint8_t topGear, float driveMaxVel, GearSet ratios, enum class LoadType loadType);
 
 
     std::string Description;
@@ -29,7 +69,7 @@ struct GearInfo {
     std::string LicensePlate;
     uint8_t TopGear;
     float DriveMaxVel;
-    std::vector<float> Ratios;
+    GearSet Ratios;
     bool ParseError;
     enum class LoadType LoadType;
 
@@ -37,3 +77,16 @@ struct GearInfo {
     bool MarkedForDeletion;
     std::string Path;
 };
+
+// Gear state a managed vehicle is kept at.
+// Plain data, so the managed vehicle list stays compact to walk every tick.
+struct ManagedGears {
+    // Stock gears of the vehicle, or edited in the menu.
+    static constexpr uint32_t NoConfig = 0;
+
+    uint8_t TopGear;
+    float DriveMaxVel;
+    GearSet Ratios;
+    // joaat of the config file path, or NoConfig.
+    uint32_t ConfigId;
+};
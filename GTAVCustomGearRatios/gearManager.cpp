@@ -0,0 +1,251 @@
+#include "gearManager.h"
+
+#include "Memory/VehicleExtensions.hpp"
+#include "Util/Logger.hpp"
+#include "Util/MathExt.h"
+#include "Util/Strings.h"
+#include "Util/Trace.h"
+
+#include <algorithm>
+#include <array>
+
+float CvtRatio(float speed, float driveMaxFlatVel, float throttle,
+    float lowRatio, float highRatio, float factor) {
+    return map(speed, 0.0f, driveMaxFlatVel, lowRatio, highRatio) *
+        factor *
+        std::clamp(throttle, 0.1f, 1.0f);
+}
+
+GearManager::GearManager(GearWorld& world, const std::vector<GearInfo>& configs, const ConfigIndex& index)
+    : mWorld(world)
+    , mConfigs(configs)
+    , mIndex(index)
+    , mNpcHistogramTimer(60000) {
+}
+
+void GearManager::ConfigsChanged() {
+    mNpcRegistry.Clear();
+    mNpcPending.clear();
+    mNpcPendingCursor = 0;
+}
+
+size_t GearManager::FindConfig(Vehicle vehicle) const {
+    return mIndex.Find(mWorld.Model(vehicle), mWorld.Plate(vehicle));
+}
+
+bool GearManager::Manage(Vehicle vehicle) {
+    if (mManaged.Contains(vehicle))
+        return false;
+    BYTE* address = mWorld.Address(vehicle);
+    if (address == nullptr)
+        return false;
+
+    VehicleView view(address);
+    ManagedGears gears{};
+    gears.TopGear = view.GetTopGear();
+    gears.DriveMaxVel = view.GetDriveMaxFlatVel();
+    // Read first: resize() zeroes the ratios it adds.
+    std::array<float, GearSet::Capacity> ratios;
+    gears.Ratios = GearSet(ratios.data(), view.GetGearRatios(ratios));
+    gears.ConfigId = ManagedGears::NoConfig;
+    mManaged.Insert(vehicle, gears);
+    LOG_DEBUG("[Management] Appended new vehicle: 0x{:X}", vehicle);
+    return true;
+}
+
+void GearManager::Apply(Vehicle vehicle, const GearInfo& config, bool updateManaged) {
+    BYTE* address = mWorld.Address(vehicle);
+    if (address == nullptr)
+        return;
+
+    VehicleView view(address);
+    view.SetTopGear(config.TopGear);
+    view.SetDriveMaxFlatVel(config.DriveMaxVel);
+    view.SetInitialDriveMaxFlatVel(config.DriveMaxVel / 1.2f);
+    view.SetGearRatios(config.Ratios.data(), static_cast<uint8_t>(config.Ratios.size()));
+
+    if (updateManaged) {
+        if (ManagedGears* gears = mManaged.Find(vehicle)) {
+            gears->TopGear = config.TopGear;
+            gears->DriveMaxVel = config.DriveMaxVel;
+            gears->Ratios = config.Ratios;
+            gears->ConfigId = config.Path.empty() ?
+                ManagedGears::NoConfig : StrUtil::joaat(config.Path.c_str());
+        }
+        else {
+            LOG_DEBUG("[Management] 0x{:X} not found?", vehicle);
+        }
+    }
+}
+
+void GearManager::ApplyBatch(const ConfigAssignment* assignments, size_t count) {
+    TRACE_SCOPE("ApplyBatch");
+    mAddresses.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        mAddresses[i] = mWorld.Address(assignments[i].Handle);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (mAddresses[i] == nullptr)
+            continue;
+        const GearInfo& config = mConfigs[assignments[i].ConfigIndex];
+        VehicleView view(mAddresses[i]);
+        view.SetTopGear(config.TopGear);
+        view.SetDriveMaxFlatVel(config.DriveMaxVel);
+        view.SetInitialDriveMaxFlatVel(config.DriveMaxVel / 1.2f);
+        view.SetGearRatios(config.Ratios.data(), static_cast<uint8_t>(config.Ratios.size()));
+    }
+}
+
+// The player vehicle is where the game changes ratios (LSC upgrades, tuning
+// scripts). When the script polls it here every tick, it's queued as soon as
+// it differs. Reapply still catches the rest.
+void GearManager::Restore(Vehicle vehicle) {
+    if (vehicle != 0) {
+        const ManagedGears* gears = mManaged.Find(vehicle);
+        BYTE* address = gears ? mWorld.Address(vehicle) : nullptr;
+        if (address && !gearsIntact(VehicleView(address), *gears))
+            mRestoreQueue.Push(vehicle);
+    }
+
+    mRestoreQueue.Dispatch([this](Vehicle queued) {
+        const ManagedGears* gears = mManaged.Find(queued);
+        BYTE* address = gears ? mWorld.Address(queued) : nullptr;
+        if (!address)
+            return;
+        VehicleView view(address);
+        if (!gearsIntact(view, *gears)) {
+            ++mStats.TotalImmediate;
+            restoreGears(queued, view, *gears);
+        }
+    });
+}
+
+void GearManager::Reapply(bool restore) {
+    // remove entities that stopped existing
+    mManaged.EraseIf([this](Vehicle vehicle, const ManagedGears&) {
+        if (mWorld.Exists(vehicle))
+            return false;
+        LOG_DEBUG("[Management] Erased stale vehicle: 0x{:X}", vehicle);
+        return true;
+    });
+
+    // Skip actually checking and setting ratios, but do keep updating the list.
+    if (!restore)
+        return;
+
+    mStats.Checked = 0;
+    mStats.Restored = 0;
+
+    for (size_t idx = 0; idx < mManaged.Size(); ++idx) {
+        Vehicle vehicle = mManaged.HandleAt(idx);
+        const ManagedGears& gears = mManaged.ValueAt(idx);
+        BYTE* address = mWorld.Address(vehicle);
+        if (!address)
+            continue;
+        VehicleView view(address);
+        ++mStats.Checked;
+        if (gearsIntact(view, gears))
+            continue;
+
+        ++mStats.Restored;
+        restoreGears(vehicle, view, gears);
+    }
+
+    mStats.TotalChecked += mStats.Checked;
+    mStats.TotalRestored += mStats.Restored;
+    if (mStats.Restored > 0) {
+        LOG_DEBUG("[Management] Restored {} of {} vehicles",
+            mStats.Restored, mStats.Checked);
+    }
+}
+
+void GearManager::UpdateNPC(int maxPerTick, int tickBudgetUs) {
+    const int64_t tickStart = NowMicros();
+    bool didWork = false;
+
+    const int gameTime = mWorld.GameTimer();
+    if (gameTime > mNpcLastUpdate + npcUpdateInterval) {
+        mNpcLastUpdate = gameTime;
+        didWork = true;
+
+        int numVehicles = mWorld.AllVehicles(mNpcVehicles.data(), static_cast<int>(mNpcVehicles.size()));
+
+        // Only vehicles that weren't around last time need a look.
+        // They're queued, and worked off over the next ticks.
+        for (int i = 0; i < numVehicles; ++i) {
+            Vehicle vehicle = mNpcVehicles[i];
+            if (mNpcRegistry.Touch(vehicle))
+                mNpcPending.push_back(vehicle);
+        }
+
+        // Despawned vehicles weren't touched, forget them.
+        size_t removed = mNpcRegistry.Sweep();
+        if (removed > 0) {
+            LOG_DEBUG("[NPC] Forgot {} despawned vehicles, tracking {}",
+                removed, mNpcRegistry.Size());
+        }
+    }
+
+    // Handle pending vehicles until either budget runs out.
+    // Configs found are applied together, after the loop.
+    mAssignments.clear();
+    int processed = 0;
+    while (mNpcPendingCursor < mNpcPending.size()) {
+        if (processed >= maxPerTick ||
+            NowMicros() - tickStart >= tickBudgetUs) {
+            break;
+        }
+
+        Vehicle vehicle = mNpcPending[mNpcPendingCursor++];
+        ++processed;
+        didWork = true;
+
+        // Might've despawned while queued
+        if (!mWorld.Exists(vehicle))
+            continue;
+
+        // Skip vehicles being managed already
+        if (mManaged.Contains(vehicle))
+            continue;
+
+        size_t configIndex = FindConfig(vehicle);
+        if (configIndex != ConfigIndex::npos)
+            mAssignments.push_back({ vehicle, configIndex });
+    }
+
+    ApplyBatch(mAssignments.data(), mAssignments.size());
+
+    if (mNpcPendingCursor == mNpcPending.size()) {
+        mNpcPending.clear();
+        mNpcPendingCursor = 0;
+    }
+
+    if (didWork) {
+        mNpcTickTimes.Add(NowMicros() - tickStart);
+    }
+
+    if (mNpcHistogramTimer.Expired()) {
+        mNpcHistogramTimer.Reset();
+        if (mNpcTickTimes.Count() > 0) {
+            LOG_DEBUG("[NPC] Tick times: {}", mNpcTickTimes.Format());
+            mNpcTickTimes.Reset();
+        }
+    }
+}
+
+// All ratios, top gear included, except gear 1 of single-gear vehicles:
+// the CVT drives that one, and it would be undone every check.
+bool GearManager::gearsIntact(const VehicleView& view, const ManagedGears& gears) const {
+    const uint8_t count = gears.TopGear == 1 ? 1 : static_cast<uint8_t>(gears.Ratios.size());
+    return view.GearsEqual(gears.TopGear, gears.DriveMaxVel, gears.Ratios.data(), count);
+}
+
+void GearManager::restoreGears(Vehicle vehicle, VehicleView& view, const ManagedGears& gears) {
+    view.SetTopGear(gears.TopGear);
+    view.SetDriveMaxFlatVel(gears.DriveMaxVel);
+    view.SetInitialDriveMaxFlatVel(gears.DriveMaxVel / 1.2f);
+    view.SetGearRatios(gears.Ratios.data(), static_cast<uint8_t>(gears.Ratios.size()));
+    if (mOnRestore)
+        mOnRestore(vehicle, gears);
+}
@@ -0,0 +1,133 @@
+#pragma once
+#include "gearInfo.h"
+#include "gearWorld.h"
+#include "configIndex.h"
+
+#include "Util/HandleMap.h"
+#include "Util/HandleSet.h"
+#include "Util/Histogram.h"
+#include "Util/RestoreQueue.h"
+#include "Util/Timer.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+class VehicleView;
+
+// What Reapply did: the last pass, and totals since the script started.
+// Restores done by Restore, between passes, are counted on their own.
+struct RestoreStats {
+    uint32_t Checked = 0;
+    uint32_t Restored = 0;
+    uint64_t TotalChecked = 0;
+    uint64_t TotalRestored = 0;
+    uint64_t TotalImmediate = 0;
+};
+
+// A vehicle and the config list entry to give it.
+struct ConfigAssignment {
+    Vehicle Handle;
+    size_t ConfigIndex;
+};
+
+// Gear ratio for a single-gear (CVT) vehicle at speed: lowRatio at standstill
+// down to highRatio at driveMaxFlatVel, scaled by factor and throttle.
+float CvtRatio(float speed, float driveMaxFlatVel, float throttle,
+    float lowRatio, float highRatio, float factor);
+
+// The gearbox side of the script: keeps managed vehicles at their gears, and
+// gives NPC vehicles their configs. Everything it knows about the game goes
+// through a GearWorld, so it runs the same without the game.
+class GearManager {
+public:
+    using RestoreCallback = std::function<void(Vehicle, const ManagedGears&)>;
+
+    // configs and index are the script's, they're only read.
+    GearManager(GearWorld& world, const std::vector<GearInfo>& configs, const ConfigIndex& index);
+
+    // After configs or index changed. NPC vehicles might match different
+    // configs now, so they're all looked at again.
+    void ConfigsChanged();
+
+    // Plate-specific config, or model generic if there's no matching plate.
+    // Returns an index into the configs, or ConfigIndex::npos.
+    size_t FindConfig(Vehicle vehicle) const;
+
+    // Starts keeping the vehicle at its current gears.
+    // Returns false if it's managed already, or doesn't exist.
+    bool Manage(Vehicle vehicle);
+    HandleMap<ManagedGears>& Managed() { return mManaged; }
+    const HandleMap<ManagedGears>& Managed() const { return mManaged; }
+    const RestoreStats& Stats() const { return mStats; }
+
+    // Called for every vehicle that had its gears restored.
+    void SetRestoreCallback(RestoreCallback callback) { mOnRestore = std::move(callback); }
+
+    // Writes the config to the vehicle. With updateManaged, it's also what a
+    // managed vehicle is kept at from then on.
+    void Apply(Vehicle vehicle, const GearInfo& config, bool updateManaged);
+
+    // Applies configs to many vehicles at once: resolves all addresses first,
+    // then writes them in one loop. Doesn't touch managed vehicles.
+    // Vehicles that don't exist anymore are skipped.
+    void ApplyBatch(const ConfigAssignment* assignments, size_t count);
+
+    // Restores queued vehicles right away. vehicle, if not 0, is checked
+    // first, and queued as soon as it differs from its managed gears.
+    void Restore(Vehicle vehicle);
+    void ClearRestores() { mRestoreQueue.Clear(); }
+    // Vehicles pushed here are restored by the next Restore, from any
+    // thread. Nothing in the script pushes to it: there is no hook on the
+    // game's gear writes, only the per-tick poll in Restore and Reapply.
+    // Only the tests use it, through a stub.
+    RestoreQueue& RestoreRequests() { return mRestoreQueue; }
+    // Forgets managed vehicles that stopped existing. With restore, checks
+    // the rest and restores those the game changed.
+    void Reapply(bool restore);
+
+    // Queues NPC vehicles that weren't seen before, once per second, and
+    // handles queued ones until either limit is hit.
+    void UpdateNPC(int maxPerTick, int tickBudgetUs);
+    size_t NpcTracked() const { return mNpcRegistry.Size(); }
+    size_t NpcPending() const { return mNpcPending.size() - mNpcPendingCursor; }
+
+private:
+    static constexpr int npcUpdateInterval = 1000;
+
+    bool gearsIntact(const VehicleView& view, const ManagedGears& gears) const;
+    void restoreGears(Vehicle vehicle, VehicleView& view, const ManagedGears& gears);
+
+    GearWorld& mWorld;
+    const std::vector<GearInfo>& mConfigs;
+    const ConfigIndex& mIndex;
+
+    // Only used to restore changes the game applies, like tuning gearbox etc
+    HandleMap<ManagedGears> mManaged;
+    RestoreStats mStats;
+    // Managed vehicles to restore on the next Restore, instead of the next
+    // Reapply. Filled by Restore's own poll of the player vehicle.
+    RestoreQueue mRestoreQueue;
+    RestoreCallback mOnRestore;
+
+    // NPC vehicles that have been queued, whether a config was found for
+    // them or not.
+    HandleSet mNpcRegistry;
+    // New NPC vehicles, waiting for a config. A few are handled per tick, to
+    // not stall a single tick in dense traffic.
+    std::vector<Vehicle> mNpcPending;
+    size_t mNpcPendingCursor = 0;
+    int mNpcLastUpdate = 0;
+
+    // Time UpdateNPC takes, for ticks where it does something.
+    DurationHistogram mNpcTickTimes;
+    Timer mNpcHistogramTimer;
+
+    // Reused, so a tick doesn't allocate once it's been this busy before.
+    std::array<Vehicle, 1024> mNpcVehicles{};
+    std::vector<ConfigAssignment> mAssignments;
+    std::vector<BYTE*> mAddresses;
+};
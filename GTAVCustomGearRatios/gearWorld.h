@@ -0,0 +1,21 @@
+#pragma once
+#include <inc/types.h>
+
+// What the gearbox logic needs from the game: entity queries, and where a
+// vehicle lives in memory. The script implements it with natives, a headless
+// build with vehicles in plain memory.
+class GearWorld {
+public:
+    virtual ~GearWorld() = default;
+
+    virtual bool Exists(Vehicle vehicle) = 0;
+    virtual Hash Model(Vehicle vehicle) = 0;
+    // nullptr if there's no plate.
+    virtual const char* Plate(Vehicle vehicle) = 0;
+    // Fills up to capacity handles, returns how many were written.
+    virtual int AllVehicles(Vehicle* vehicles, int capacity) = 0;
+    // Vehicle struct, for VehicleView. nullptr if it doesn't exist.
+    virtual BYTE* Address(Vehicle vehicle) = 0;
+    // Milliseconds.
+    virtual int GameTimer() = 0;
+};
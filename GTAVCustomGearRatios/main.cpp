@@ -9,6 +9,7 @@
 #include "Util/FileVersion.h"
 #include "Util/Paths.h"
 #include "Util/Logger.hpp"
+#include "Memory/NativeMemory.hpp"
 #include "Memory/Versions.h"
 #include "Memory/VehicleExtensions.hpp"
 
@@ -20,6 +21,7 @@ void resolveVersion() {
     logger.Write(INFO, "SHV API Game version: %s (%d)", eGameVersionToString(shvVersion).c_str(), shvVersion);
     // Also prints the other stuff, annoyingly.
     SVersion exeVersion = getExeInfo();
+    mem::SetExeVersion(exeVersion);
 
     if (shvVersion < G_VER_1_0_877_1_STEAM) {
         logger.Write(WARN, "Outdated game version! Update your game.");
@@ -86,6 +88,7 @@ BOOL APIENTRY DllMain(HMODULE hInstance, DWORD reason, LPVOID lpReserved) {
         }
         case DLL_PROCESS_DETACH: {
             scriptUnregister(hInstance);
+            logger.CloseAtDetach();
             break;
         }
         default: {
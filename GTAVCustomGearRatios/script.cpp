@@ -2,9 +2,16 @@
 #include "scriptSettings.h"
 #include "scriptMenu.h"
 #include "gearInfo.h"
+#include "configIndex.h"
+#include "configLoader.h"
+#include "configWatcher.h"
+#include "gearManager.h"
+#include "gearWorld.h"
 
 #include "Memory/VehicleExtensions.hpp"
 
+#include "Util/Profiler.h"
+#include "Util/Trace.h"
 #include "Util/Timer.h"
 #include "Util/Logger.hpp"
 #include "Util/ScriptUtils.h"
@@ -16,7 +23,9 @@
 
 #include <fmt/core.h>
 
+#include <array>
 #include <filesystem>
+#include <thread>
 
 #include "Constants.h"
 #include "Memory/Offsets.hpp"
@@ -41,10 +50,65 @@ Vehicle previousVehicle;
 Vehicle currentVehicle;
 
 std::string gearConfigDir;
+std::string gearConfigPack;
 std::vector<GearInfo> gearConfigs;
-
-// Only used to restore changes the game applies, like tuning gearbox etc
-std::vector<std::pair<Vehicle, GearInfo>> currentConfigs;
+// What gearConfigs was loaded from, so reloads only parse changed files.
+ConfigManifest configManifest;
+// Reloads configs in the background when enabled. While running, it owns
+// configManifest.
+ConfigWatcher configWatcher;
+// Rebuilt with gearConfigs, in parseConfigs.
+ConfigIndex gearConfigIndex;
+
+// The game, as gearManager sees it.
+class NativeWorld : public GearWorld {
+public:
+    bool Exists(Vehicle vehicle) override {
+        return ENTITY::DOES_ENTITY_EXIST(vehicle);
+    }
+    Hash Model(Vehicle vehicle) override {
+        return ENTITY::GET_ENTITY_MODEL(vehicle);
+    }
+    const char* Plate(Vehicle vehicle) override {
+        return VEHICLE::GET_VEHICLE_NUMBER_PLATE_TEXT(vehicle);
+    }
+    int AllVehicles(Vehicle* vehicles, int capacity) override {
+        return worldGetAllVehicles(vehicles, capacity);
+    }
+    BYTE* Address(Vehicle vehicle) override {
+        return VExt::GetAddress(vehicle);
+    }
+    int GameTimer() override {
+        return MISC::GET_GAME_TIMER();
+    }
+};
+
+NativeWorld nativeWorld;
+// Managed vehicles, and NPC vehicles waiting for a config.
+GearManager gearManager(nativeWorld, gearConfigs, gearConfigIndex);
+
+// Stages of the main loop, as tickProfiler numbers them.
+enum TickStage : size_t {
+    StageConfigs,
+    StagePlayer,
+    StageNPC,
+    StageMenu,
+    StageCVT,
+    StageRestore,
+    StageReapply,
+};
+TickProfiler tickProfiler({
+    "update_configs",
+    "update_player",
+    "update_npc",
+    "update_menu",
+    "update_cvt",
+    "update_restore",
+    "update_reapply",
+});
+
+// Ends the trace capture, see ScriptSettings::Trace.
+Timer traceTimer(0);
 
 float cvtMaxRpm = 0.9f;
 float cvtMinRpm = 0.3f;
@@ -53,9 +117,33 @@ Timer auxTimer(1000);
 
 void applyConfig(const GearInfo& config, Vehicle vehicle, bool notify, bool updateCurrent);
 
+// Replaces the config list, keeping configs marked for deletion marked.
+void setConfigs(std::vector<GearInfo>&& configs) {
+    std::vector<std::string> markedPaths;
+    for (const auto& config : gearConfigs) {
+        if (config.MarkedForDeletion)
+            markedPaths.push_back(config.Path);
+    }
+
+    gearConfigs = std::move(configs);
+    for (auto& config : gearConfigs) {
+        config.MarkedForDeletion =
+            std::find(markedPaths.begin(), markedPaths.end(), config.Path) != markedPaths.end();
+    }
+    gearConfigIndex.Build(gearConfigs);
+    gearManager.ConfigsChanged();
+}
+
 void parseConfigs() {
     namespace fs = std::filesystem;
-    gearConfigs.clear();
+    TRACE_SCOPE("parseConfigs");
+    // Keeps everything up to date by itself.
+    if (configWatcher.Running()) {
+        for (auto& config : gearConfigs) {
+            config.MarkedForDeletion = false;
+        }
+        return;
+    }
 
     if (!(fs::exists(fs::path(gearConfigDir)) && fs::is_directory(fs::path(gearConfigDir)))) {
         logger.Write(ERROR, "Directory [%s] not found, creating an empty one.", gearConfigDir.c_str());
@@ -68,22 +156,61 @@ void parseConfigs() {
                 gearConfigDir.c_str(),
                 ex.what());
             logger.Write(FATAL, "Directory [%s] couldn't be created, skipping config loading.", gearConfigDir.c_str());
+            gearConfigs.clear();
+            gearConfigIndex.Clear();
+            configManifest.Clear();
             return;
         }
     }
 
-    for (const auto& p : fs::directory_iterator(gearConfigDir)) {
-        if (p.path().extension() == ".xml") {
-            GearInfo info = GearInfo::ParseConfig(p.path().string());
-            if (!info.ParseError) {
-                info.Path = p.path().string();
-                gearConfigs.push_back(info);
-            }
-            else {
-                logger.Write(ERROR, "%s skipped due to errors", p.path().stem().string().c_str());
-            }
+    const unsigned threads = std::clamp(std::thread::hardware_concurrency(), 1u, 4u);
+    const int64_t parseStart = NowMicros();
+    ConfigManifest::Stats stats;
+    bool changed = configManifest.Refresh(gearConfigDir, threads, stats);
+    LOG_DEBUG("Refreshed {} configs in {:.3f} ms: {} parsed, {} unchanged after rehash, {} removed",
+        stats.Total, static_cast<double>(NowMicros() - parseStart) / 1000.0,
+        stats.Parsed, stats.Rehashed, stats.Removed);
+
+    // Also keep the stamps in the pack up to date, for files that were only touched.
+    if (changed || stats.Rehashed > 0) {
+        configManifest.SavePack(gearConfigPack);
+    }
+
+    if (!changed) {
+        // Same configs, only forget pending deletions like a fresh load would.
+        for (auto& config : gearConfigs) {
+            config.MarkedForDeletion = false;
+        }
+        return;
+    }
+
+    std::vector<GearInfo> configs;
+    configManifest.GetConfigs(configs);
+    for (auto& config : gearConfigs) {
+        config.MarkedForDeletion = false;
+    }
+    setConfigs(std::move(configs));
+}
+
+// Starts or stops the config watcher with its setting, and takes configs it
+// loaded in the background.
+void update_configs() {
+    if (settings.WatchConfigs && !configWatcher.Running()) {
+        const unsigned threads = std::clamp(std::thread::hardware_concurrency(), 1u, 4u);
+        if (!configWatcher.Start(gearConfigDir, configManifest, gearConfigPack, threads)) {
+            UI::Notify(INFO, "Failed to watch the config folder, check log.");
+            settings.WatchConfigs = false;
         }
     }
+    else if (!settings.WatchConfigs && configWatcher.Running()) {
+        configWatcher.Stop();
+    }
+
+    std::vector<GearInfo> configs;
+    if (configWatcher.Poll(configs)) {
+        setConfigs(std::move(configs));
+        LOG_DEBUG("[Watcher] {} configs live", gearConfigs.size());
+    }
 }
 
 void eraseConfigs() {
@@ -96,7 +223,7 @@ void eraseConfigs() {
                 error++;
             }
             else {
-                logger.Write(DEBUG, "Removed file %s", config.Path.c_str());
+                LOG_DEBUG("Removed file {}", config.Path);
                 deleted++;
             }
         }
@@ -110,32 +237,10 @@ void eraseConfigs() {
 }
 
 void tryApplyConfig(Vehicle vehicle, bool autoNotify, bool updateCurrent) {
-    auto foundConfigModelAndPlate = std::find_if(gearConfigs.begin(), gearConfigs.end(), [&](const GearInfo& other) {
-        const char* plateNpc = VEHICLE::GET_VEHICLE_NUMBER_PLATE_TEXT(vehicle);
-        bool samePlate = plateNpc && StrUtil::loose_match(other.LicensePlate, plateNpc);
-        auto model = ENTITY::GET_ENTITY_MODEL(vehicle);
-        bool sameModel = MISC::GET_HASH_KEY(other.ModelName.c_str()) == model ||
-            other.ModelHash == model;
-        return samePlate && sameModel;
-        });
-
-    if (foundConfigModelAndPlate != gearConfigs.end()) {
-        // Apply plate-specific
-        applyConfig(*foundConfigModelAndPlate, vehicle, autoNotify, updateCurrent);
-    }
-    else {
-        // Or apply model generic if there's no matching plate.
-        auto foundConfigModel = std::find_if(gearConfigs.begin(), gearConfigs.end(), [&](const GearInfo& other) {
-            auto model = ENTITY::GET_ENTITY_MODEL(vehicle);
-            bool sameModel = MISC::GET_HASH_KEY(other.ModelName.c_str()) == model ||
-                other.ModelHash == model;
-
-            return sameModel && other.LoadType == LoadType::Model;
-            });
-
-        if (foundConfigModel != gearConfigs.end()) {
-            applyConfig(*foundConfigModel, vehicle, autoNotify, updateCurrent);
-        }
+    size_t configIndex = gearManager.FindConfig(vehicle);
+
+    if (configIndex != ConfigIndex::npos) {
+        applyConfig(gearConfigs[configIndex], vehicle, autoNotify, updateCurrent);
     }
 }
 
@@ -145,117 +250,81 @@ void update_player() {
     if (ENTITY::DOES_ENTITY_EXIST(currentVehicle) && currentVehicle != previousVehicle) {
         previousVehicle = currentVehicle;
 
-        if (std::find_if(currentConfigs.begin(), currentConfigs.end(), [=](const auto& cfg) {return cfg.first == currentVehicle; }) == currentConfigs.end()) {
-            currentConfigs.emplace_back(currentVehicle, GearInfo("noconfig",
-                "noconfig",
-                0,
-                "noconfig",
-                VExt::GetTopGear(currentVehicle),
-                VExt::GetDriveMaxFlatVel(currentVehicle),
-                VExt::GetGearRatios(currentVehicle),
-                LoadType::None)
-            );
-            logger.Write(DEBUG, "[Management] Appended new vehicle: 0x%X", currentVehicle);
-        }
-
+        gearManager.Manage(currentVehicle);
         tryApplyConfig(currentVehicle, settings.AutoNotify, true);
     }
 }
 
 void update_cvt() {    
     if (settings.EnableCVT && ENTITY::DOES_ENTITY_EXIST(currentVehicle)) {
-        bool handlingCvt = *reinterpret_cast<uint8_t*>(VExt::GetHandlingPtr(currentVehicle) + hOffsets1604.dwStrHandlingFlags) & 0x00001000;
-        if (VExt::GetTopGear(currentVehicle) == 1) {
-            float defaultMaxFlatVel = VExt::GetDriveMaxFlatVel(currentVehicle);
-            float currSpeed = avg(VExt::GetTyreSpeeds(currentVehicle));
-            float newRatio = 
-                map(currSpeed, 0.0f, defaultMaxFlatVel, settings.CVT.LowRatio, settings.CVT.HighRatio) * 
-                settings.CVT.Factor * 
-                std::clamp(VExt::GetThrottleP(currentVehicle), 0.1f, 1.0f);
+        VehicleView view(currentVehicle);
+        bool handlingCvt = *reinterpret_cast<uint8_t*>(view.GetHandlingPtr() + hOffsets1604.dwStrHandlingFlags) & 0x00001000;
+        if (view.GetTopGear() == 1) {
+            float defaultMaxFlatVel = view.GetDriveMaxFlatVel();
+            WheelSnapshot wheels;
+            view.GetWheelSnapshot(wheels);
+            float currSpeed = wheels.NumWheels == 0 ? 0.0f : avg(wheels.TyreSpeeds.data(), wheels.NumWheels);
+            float newRatio = CvtRatio(currSpeed, defaultMaxFlatVel, view.GetThrottleP(),
+                settings.CVT.LowRatio, settings.CVT.HighRatio, settings.CVT.Factor);
             //newRatio = std::clamp(newRatio, 0.6f, 3.33f);
-            *VExt::GetGearRatioPtr(currentVehicle, 1) = newRatio;
+            *view.GetGearRatioPtr(1) = newRatio;
         }
     }
 }
 
-void update_reapply() {
-    // remove entities that stopped existing
-    currentConfigs.erase(std::remove_if(currentConfigs.begin(), currentConfigs.end(), 
-        [=](const auto& cfgPair) {
-            if (!ENTITY::DOES_ENTITY_EXIST(cfgPair.first)) {
-                logger.Write(DEBUG, "[Management] Erased stale vehicle: 0x%X", cfgPair.first);
-            }
-            return !ENTITY::DOES_ENTITY_EXIST(cfgPair.first);
-        }), currentConfigs.end());
+void notifyRestored(Vehicle vehicle, const ManagedGears& gears) {
+    if (settings.AutoNotify) {
+        UI::Notify(INFO, fmt::format("Restored {}: \n"
+            "Top gear = {}\n"
+            "Top speed = {:.0f} kph", vehicle, gears.TopGear,
+            3.6f * gears.DriveMaxVel / gears.Ratios[gears.TopGear]));
+    }
+}
 
-    // Skip actually checking and setting ratios, but do keep updating the list.
-    if (!settings.RestoreRatios)
+// Restores queued vehicles right away. With RestoreImmediate, the player
+// vehicle is also polled every tick. update_reapply still catches the rest.
+void update_restore() {
+    if (!settings.RestoreRatios) {
+        gearManager.ClearRestores();
         return;
-
-    for (const auto& cfgPair : currentConfigs) {
-        auto vehicle = cfgPair.first;
-        auto config = cfgPair.second;
-        bool topGearChanged = VExt::GetTopGear(vehicle) != config.TopGear;
-        bool driveMaxVelChanged = VExt::GetDriveMaxFlatVel(vehicle) != config.DriveMaxVel;
-        bool anyRatioChanged = false;
-        if (!topGearChanged && !driveMaxVelChanged) {
-            auto extRatios = VExt::GetGearRatios(vehicle);
-            for (uint32_t i = 0; i < config.TopGear; ++i) {
-                if (extRatios[i] != config.Ratios[i]) {
-                    anyRatioChanged = true;
-                    break;
-                }
-            }
-        }
-
-        if (topGearChanged || driveMaxVelChanged || anyRatioChanged) {
-            VExt::SetTopGear(vehicle, config.TopGear);
-            VExt::SetDriveMaxFlatVel(vehicle, config.DriveMaxVel);
-            VExt::SetInitialDriveMaxFlatVel(vehicle, config.DriveMaxVel / 1.2f);
-            VExt::SetGearRatios(vehicle, config.Ratios);
-            if (settings.AutoNotify) {
-                UI::Notify(INFO, fmt::format("Restored {}: \n"
-                    "Top gear = {}\n"
-                    "Top speed = {:.0f} kph", vehicle, config.TopGear,
-                    3.6f * config.DriveMaxVel / config.Ratios[config.TopGear]));
-            }
-        }
     }
-}
 
-int npcUpdateInterval = 1000;
-int lastUpdate = 0;
+    gearManager.Restore(settings.RestoreImmediate ? currentVehicle : 0);
+}
 
-void UpdateRatios(Vehicle vehicle, const GearInfo& config) {
-    VExt::SetTopGear(vehicle, config.TopGear);
-    VExt::SetDriveMaxFlatVel(vehicle, config.DriveMaxVel);
-    VExt::SetInitialDriveMaxFlatVel(vehicle, config.DriveMaxVel / 1.2f);
-    VExt::SetGearRatios(vehicle, config.Ratios);
+void update_reapply() {
+    gearManager.Reapply(settings.RestoreRatios);
 }
 
 void update_npc() {
     if (!settings.EnableNPC)
         return;
 
-    if (MISC::GET_GAME_TIMER() > lastUpdate + npcUpdateInterval) {
-        lastUpdate = MISC::GET_GAME_TIMER();
+    gearManager.UpdateNPC(settings.NPC.MaxPerTick, settings.NPC.TickBudgetUs);
+}
 
-        std::vector<Vehicle> npcVehicles(1024);
-        int numVehicles = worldGetAllVehicles(npcVehicles.data(), 1024);
-        npcVehicles.resize(numVehicles);
+void startTrace() {
+    Tracing::Start();
+    traceTimer.Reset(static_cast<int64_t>(settings.Trace.Seconds) * 1000);
+}
 
-        for (const auto& vehicle : npcVehicles) {
-            // Skip vehicles being managed already
-            auto managedConfigIt = std::find_if(currentConfigs.begin(), currentConfigs.end(), [&](const auto& cfgPair) {
-                return vehicle == cfgPair.first;
-            });
+void update_trace() {
+    if (!Tracing::Recording()) {
+        if (settings.Trace.Enable)
+            startTrace();
+        return;
+    }
 
-            if (managedConfigIt != currentConfigs.end())
-                continue;
+    if (settings.Trace.Enable && !traceTimer.Expired())
+        return;
 
-            tryApplyConfig(vehicle, false, false);
-        }
-    }
+    Tracing::Stop();
+    settings.Trace.Enable = false;
+    const std::string traceFile = absoluteModPath + "\\trace.json";
+    if (Tracing::Write(traceFile))
+        UI::Notify(INFO, fmt::format("Trace saved to {}", traceFile));
+    else
+        UI::Notify(INFO, "Failed to save trace, check log.");
 }
 
 void main() {
@@ -264,16 +333,26 @@ void main() {
     settingsGeneralFile = absoluteModPath + "\\settings_general.ini";
     settingsMenuFile = absoluteModPath + "\\settings_menu.ini";
     gearConfigDir = absoluteModPath + "\\Configs";
+    gearConfigPack = absoluteModPath + "\\configs.cgrpack";
     
     settings.SetFiles(settingsGeneralFile);
     menu.SetFiles(settingsMenuFile);
 
     settings.Read();
     logger.SetMinLevel(settings.Debug ? DEBUG : INFO);
+    // Early, to see the offset scan and the first config load. Later reads
+    // don't start another one.
+    settings.Trace.Enable = settings.Trace.Capture;
+    if (settings.Trace.Enable)
+        startTrace();
 
     menu.ReadSettings();
     menu.Initialize();
-    VExt::Init();
+    gearManager.SetRestoreCallback(notifyRestored);
+    VExt::Init(absoluteModPath + "\\offsets.ini");
+    if (configManifest.LoadPack(gearConfigPack)) {
+        LOG_DEBUG("Loaded config pack [{}]", gearConfigPack);
+    }
     parseConfigs();
 
     menu.RegisterOnMain([&] {
@@ -289,14 +368,22 @@ void main() {
     });
 
     while (true) {
-        update_player();
-        update_npc();
-        update_menu();
-        update_cvt();
-        if (auxTimer.Expired()) {
-            auxTimer.Reset();
-            update_reapply();
+        {
+            TRACE_SCOPE("tick");
+            tickProfiler.BeginTick();
+            { TickProfiler::Scope scope(tickProfiler, StageConfigs); update_configs(); }
+            { TickProfiler::Scope scope(tickProfiler, StagePlayer); update_player(); }
+            { TickProfiler::Scope scope(tickProfiler, StageNPC); update_npc(); }
+            { TickProfiler::Scope scope(tickProfiler, StageMenu); update_menu(); }
+            { TickProfiler::Scope scope(tickProfiler, StageCVT); update_cvt(); }
+            { TickProfiler::Scope scope(tickProfiler, StageRestore); update_restore(); }
+            if (auxTimer.Expired()) {
+                auxTimer.Reset();
+                TickProfiler::Scope scope(tickProfiler, StageReapply);
+                update_reapply();
+            }
         }
+        update_trace();
         WAIT(0);
     }
 }
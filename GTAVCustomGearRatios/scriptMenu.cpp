@@ -13,8 +13,11 @@
 #include "Util/MathExt.h"
 
 #include "script.h"
+#include "gearManager.h"
 #include "scriptSettings.h"
 #include "gearInfo.h"
+#include "Util/HandleMap.h"
+#include "Util/Profiler.h"
 #include "Util/ScriptUtils.h"
 #include "Util/Strings.h"
 
@@ -25,10 +28,12 @@ extern ScriptSettings settings;
 extern Vehicle currentVehicle;
 extern VehicleExtensions ext;
 
+extern std::string absoluteModPath;
 extern std::string gearConfigDir;
 
 extern std::vector<GearInfo> gearConfigs;
-extern std::vector<std::pair<Vehicle, GearInfo>> currentConfigs;
+extern GearManager gearManager;
+extern TickProfiler tickProfiler;
 
 template <typename T>
 void incVal(T& val, const T max, const T step) {
@@ -95,33 +100,16 @@ std::string GetKbEntryString(const std::string& existingString) {
 }
 
 void applyConfig(const GearInfo& config, Vehicle vehicle, bool notify, bool updateCurrent) {
-    ext.SetTopGear(vehicle, config.TopGear);
-    ext.SetDriveMaxFlatVel(vehicle, config.DriveMaxVel);
-    ext.SetInitialDriveMaxFlatVel(vehicle, config.DriveMaxVel / 1.2f);
-    ext.SetGearRatios(vehicle, config.Ratios);
+    gearManager.Apply(vehicle, config, updateCurrent);
     if (notify) {
         UI::Notify(INFO, fmt::format("[{}] applied to current {}",
             config.Description.c_str(), Util::GetFormattedVehicleModelName(vehicle).c_str()));
     }
-
-    if (updateCurrent) {
-        auto currCfgCombo = std::find_if(currentConfigs.begin(), currentConfigs.end(), [=](const auto& cfg) {return cfg.first == vehicle; });
-
-        if (currCfgCombo != currentConfigs.end()) {
-            auto& currentConfig = currCfgCombo->second;
-            currentConfig.TopGear = config.TopGear;
-            currentConfig.DriveMaxVel = config.DriveMaxVel;
-            currentConfig.Ratios = config.Ratios;
-        }
-        else {
-            logger.Write(DEBUG, "[Management] 0x%X not found?", vehicle);
-        }
-    }
 }
 
 std::vector<std::string> printInfo(const GearInfo& info) {
     uint8_t topGear = info.TopGear;
-    auto ratios = info.Ratios;
+    const auto& ratios = info.Ratios;
     //float maxVel = (fInitialDriveMaxFlatVel * 1.2f) / 0.9f;
     float maxVel = info.DriveMaxVel;
 
@@ -167,10 +155,12 @@ std::vector<std::string> printInfo(const GearInfo& info) {
 }
 
 std::vector<std::string> printGearStatus(Vehicle vehicle, uint8_t tunedGear) {
-    uint8_t topGear = ext.GetTopGear(vehicle);
-    uint16_t currentGear = ext.GetGearCurr(vehicle);
-    float maxVel = ext.GetDriveMaxFlatVel(vehicle);
-    auto ratios = ext.GetGearRatios(vehicle);
+    VehicleView view(vehicle);
+    uint8_t topGear = view.GetTopGear();
+    uint16_t currentGear = view.GetGearCurr();
+    float maxVel = view.GetDriveMaxFlatVel();
+    std::array<float, GearSet::Capacity> ratios{};
+    uint8_t numRatios = view.GetGearRatios(ratios);
 
     std::vector<std::string> lines = {
         fmt::format("Top gear: {}", topGear),
@@ -180,7 +170,7 @@ std::vector<std::string> printGearStatus(Vehicle vehicle, uint8_t tunedGear) {
         "Gear ratios:",
     };
 
-    for (uint8_t i = 0; i <= topGear; ++i) {
+    for (uint8_t i = 0; i < numRatios; ++i) {
         std::string prefix;
         if (i == 0) {
             prefix = "Reverse";
@@ -205,9 +195,11 @@ std::vector<std::string> printGearStatus(Vehicle vehicle, uint8_t tunedGear) {
 }
 
 void promptSave(Vehicle vehicle, LoadType loadType) {
-    uint8_t topGear = ext.GetTopGear(vehicle);
-    float driveMaxVel = ext.GetDriveMaxFlatVel(vehicle);
-    std::vector<float> ratios = ext.GetGearRatios(vehicle);
+    VehicleView view(vehicle);
+    uint8_t topGear = view.GetTopGear();
+    float driveMaxVel = view.GetDriveMaxFlatVel();
+    std::array<float, GearSet::Capacity> readRatios;
+    GearSet ratios(readRatios.data(), view.GetGearRatios(readRatios));
 
     std::string modelName = VEHICLE::GET_DISPLAY_NAME_FROM_VEHICLE_MODEL(ENTITY::GET_ENTITY_MODEL(vehicle));
 
@@ -426,17 +418,17 @@ void update_ratiomenu() {
     }
 
     if (anyChanged) {
-        auto currCfgCombo = std::find_if(currentConfigs.begin(), currentConfigs.end(), [=](const auto& cfg) {return cfg.first == currentVehicle; });
-        
-        if (currCfgCombo != currentConfigs.end()) {
-            auto& currentConfig = currCfgCombo->second;
-            currentConfig.TopGear = ext.GetTopGear(currentVehicle);
-            currentConfig.DriveMaxVel = ext.GetDriveMaxFlatVel(currentVehicle);
-            currentConfig.Ratios = ext.GetGearRatios(currentVehicle);
+        if (ManagedGears* currentConfig = gearManager.Managed().Find(currentVehicle)) {
+            VehicleView view(currentVehicle);
+            currentConfig->TopGear = view.GetTopGear();
+            currentConfig->DriveMaxVel = view.GetDriveMaxFlatVel();
+            std::array<float, GearSet::Capacity> ratios;
+            currentConfig->Ratios = GearSet(ratios.data(), view.GetGearRatios(ratios));
+            currentConfig->ConfigId = ManagedGears::NoConfig;
         }
         else {
             UI::Notify(INFO, "Something messed up, check log.");
-            logger.Write(ERROR, "Could not find currvehicle {} in list of vehicles?", currentVehicle);
+            LOG_ERROR("Could not find currvehicle 0x{:X} in list of vehicles?", currentVehicle);
         }
     }
 }
@@ -531,12 +523,66 @@ void update_optionsmenu() {
     menu.BoolOption("Override game ratio changes", settings.RestoreRatios,
         { "Restores user-set ratios when the game changes them,"
             " for example gearbox upgrades in LSC." });
+    if (settings.RestoreRatios) {
+        menu.BoolOption("Poll current vehicle every tick", settings.RestoreImmediate,
+            { "Extra polling: compares the current vehicle's gears every tick,"
+                " so game changes are undone right away, at a small cost per tick.",
+                "Without it, all vehicles are checked once per second." });
+        menu.Option(fmt::format("Restored {} of {} vehicles", gearManager.Stats().Restored, gearManager.Stats().Checked),
+            { "Vehicles checked and restored in the last pass, once per second.",
+                fmt::format("Since loading: {} restored, {} checked.",
+                    gearManager.Stats().TotalRestored, gearManager.Stats().TotalChecked),
+                fmt::format("Restored between passes: {}.", gearManager.Stats().TotalImmediate) });
+    }
     menu.BoolOption("Autoload notifications", settings.AutoNotify,
         { "Show a notification when autoload applied a preset." });
     menu.BoolOption("Enable CVT when 1 gear", settings.EnableCVT,
         { "Enable custom CVT when setting number of gears to 1 in a car that doesn't come with CVT." });
     menu.BoolOption("Enable for NPCs", settings.EnableNPC,
         { "Enables custom gear ratios for NPCs. Autoload configuration is used to select ratios." });
+    menu.BoolOption("Watch config folder", settings.WatchConfigs,
+        { "Load new and changed configs in the background, as soon as they're saved,"
+            " instead of when opening the menu." });
+    menu.MenuOption("Performance", "perfmenu", { "Script tick timings." });
+}
+
+void update_perfmenu() {
+    menu.Title("Performance");
+    menu.Subtitle("p50 / p99 / max, microseconds");
+
+    auto stageOption = [](const std::string& name, const TickProfiler::Summary& summary) {
+        if (summary.Samples == 0) {
+            menu.Option(fmt::format("{}: -", name), { "Didn't run in the recorded ticks." });
+            return;
+        }
+        menu.Option(fmt::format("{}: {:.0f} / {:.0f} / {:.0f}", name, summary.P50, summary.P99, summary.Max),
+            { fmt::format("Ran in {} of the last {} recorded ticks.", summary.Samples, TickProfiler::Capacity),
+                fmt::format("p50: {:.1f} us", summary.P50),
+                fmt::format("p99: {:.1f} us", summary.P99),
+                fmt::format("max: {:.1f} us", summary.Max) });
+    };
+
+    for (size_t stage = 0; stage < tickProfiler.Stages(); ++stage) {
+        stageOption(tickProfiler.StageName(stage), tickProfiler.Summarize(stage));
+    }
+    stageOption("Total", tickProfiler.Summarize(tickProfiler.Stages()));
+
+    menu.BoolOption("Record trace", settings.Trace.Enable,
+        { fmt::format("Records the next {} seconds to trace.json in the mod folder,", settings.Trace.Seconds),
+            "for chrome://tracing or Perfetto. Disable to stop early.",
+            "TraceSeconds in settings_general.ini sets the length." });
+
+    if (menu.Option("Reset", { "Clear the recorded ticks." })) {
+        tickProfiler.Reset();
+    }
+
+    const std::string csvFile = absoluteModPath + "\\profile.csv";
+    if (menu.Option("Dump to CSV", { "Write the recorded ticks to profile.csv in the mod folder." })) {
+        if (tickProfiler.WriteCsv(csvFile))
+            UI::Notify(INFO, fmt::format("Saved {}", csvFile));
+        else
+            UI::Notify(INFO, "Failed to save profile, check log.");
+    }
 }
 
 void update_menu() {
@@ -553,5 +599,7 @@ void update_menu() {
     
     if (menu.CurrentMenu("optionsmenu")) { update_optionsmenu(); }
 
+    if (menu.CurrentMenu("perfmenu")) { update_perfmenu(); }
+
     menu.EndMenu();
 }
\ No newline at end of file
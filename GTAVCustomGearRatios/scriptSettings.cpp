@@ -1,13 +1,16 @@
 #include "scriptSettings.h"
 
 #include <simpleini/SimpleIni.h>
+#include <algorithm>
 
 ScriptSettings::ScriptSettings()
     : AutoLoad(true)
     , AutoLoadGeneric(true)
     , RestoreRatios(true)
+    , RestoreImmediate(false)
     , EnableCVT(false)
     , AutoNotify(true)
+    , WatchConfigs(false)
     , Debug(false) {}
 
 void ScriptSettings::SetFiles(const std::string &general) {
@@ -26,9 +29,17 @@ void ScriptSettings::Save() const {
     settings.SetBoolValue("OPTIONS", "AutoLoad", AutoLoad);
     settings.SetBoolValue("OPTIONS", "AutoLoadGeneric", AutoLoadGeneric);
     settings.SetBoolValue("OPTIONS", "RestoreRatios", RestoreRatios);
+    settings.SetBoolValue("OPTIONS", "RestoreImmediate", RestoreImmediate);
     settings.SetBoolValue("OPTIONS", "EnableCVT", EnableCVT);
     settings.SetBoolValue("Options", "AutoNotify", AutoNotify);
     settings.SetBoolValue("Options", "EnableNPC", EnableNPC);
+    settings.SetBoolValue("OPTIONS", "WatchConfigs", WatchConfigs);
+
+    settings.SetLongValue("NPC", "MaxPerTick", NPC.MaxPerTick);
+    settings.SetLongValue("NPC", "TickBudgetUs", NPC.TickBudgetUs);
+
+    settings.SetBoolValue("DEBUG", "TraceCapture", Trace.Capture);
+    settings.SetLongValue("DEBUG", "TraceSeconds", Trace.Seconds);
 
     settings.SaveFile(settingsGeneralFile.c_str());
 }
@@ -42,10 +53,18 @@ void ScriptSettings::parseSettings() {
     AutoLoad = settings.GetBoolValue("OPTIONS", "AutoLoad", true);
     AutoLoadGeneric = settings.GetBoolValue("OPTIONS", "AutoLoadGeneric", true);
     RestoreRatios = settings.GetBoolValue("OPTIONS", "RestoreRatios", true);
+    RestoreImmediate = settings.GetBoolValue("OPTIONS", "RestoreImmediate", false);
     EnableCVT = settings.GetBoolValue("OPTIONS", "EnableCVT", false);
     AutoNotify = settings.GetBoolValue("OPTIONS", "AutoNotify", true);
     EnableNPC = settings.GetBoolValue("OPTIONS", "EnableNPC", false);
+    WatchConfigs = settings.GetBoolValue("OPTIONS", "WatchConfigs", false);
+
+    // [NPC]
+    NPC.MaxPerTick = std::max(1, static_cast<int>(settings.GetLongValue("NPC", "MaxPerTick", 8)));
+    NPC.TickBudgetUs = std::max(1, static_cast<int>(settings.GetLongValue("NPC", "TickBudgetUs", 500)));
 
     // [DEBUG]
     Debug = settings.GetBoolValue("DEBUG", "LogDebug", false);
+    Trace.Capture = settings.GetBoolValue("DEBUG", "TraceCapture", false);
+    Trace.Seconds = std::max(1, static_cast<int>(settings.GetLongValue("DEBUG", "TraceSeconds", 10)));
 }
@@ -16,6 +16,9 @@ public:
     bool AutoLoadGeneric;
     // Restore ratios when the game changes them
     bool RestoreRatios;
+    // Extra polling: also compare the player vehicle's gears every tick,
+    // instead of only every second. Off by default, it costs every tick.
+    bool RestoreImmediate;
     // Custom CVT when 1 gear active
     bool EnableCVT;
     
@@ -29,9 +32,27 @@ public:
     bool AutoNotify;
     // Enable for NPC
     bool EnableNPC;
+    // Reload configs in the background when files in Configs change
+    bool WatchConfigs;
+
+    // [NPC]
+    // New NPC vehicles are handled over multiple ticks. A tick stops taking
+    // more when either limit is hit.
+    struct {
+        int MaxPerTick = 8;
+        int TickBudgetUs = 500;
+    } NPC;
 
     // [DEBUG]
     bool Debug;
+    // Record a Chrome trace to trace.json for Seconds. Capture records one
+    // from loading, menu re-reads don't start another. Enable is whether one
+    // is recording, the menu toggles it and it isn't saved.
+    struct {
+        bool Capture = false;
+        int Seconds = 10;
+        bool Enable = false;
+    } Trace;
 
 private:
     void parseSettings();